@@ -25,6 +25,7 @@
 #include "Clover_Audio.cpp"
 #include "Clover_Draw.cpp"
 #include "Clover_UI.cpp"
+#include "Clover_Timers.cpp"
 
 
 global_variable entity *Player = {};
@@ -63,33 +64,35 @@ GetRandomReal32_Range(real32 Minimum, real32 Maximum)
     return((Maximum - Minimum)*GetRandomReal32() + Minimum);
 }
 
+// NOTE(Sleepster): Each sprite is the png of the same name in SPRITE_DIRECTORY, packed into the atlas at startup
 internal inline void
-LoadSpriteData(game_state *State)
-{
-    State->GameData.Sprites[SPRITE_Nil]                   = {.AtlasOffset = {  0,  0}, .SpriteSize = {16, 16}};
-    State->GameData.Sprites[SPRITE_Player]                = {.AtlasOffset = { 17,  0}, .SpriteSize = {12, 11}};
-    State->GameData.Sprites[SPRITE_UIItemBox]             = {.AtlasOffset = {112,  0}, .SpriteSize = {16, 16}};
-    State->GameData.Sprites[SPRITE_ToolPickaxe]           = {.AtlasOffset = {  0, 48}, .SpriteSize = {11, 13}};
-    State->GameData.Sprites[SPRITE_ToolWoodAxe]           = {.AtlasOffset = { 16, 48}, .SpriteSize = {11, 13}};
-    State->GameData.Sprites[SPRITE_FullHeartContainer]    = {.AtlasOffset = {  0, 64}, .SpriteSize = {11,  9}};
-    State->GameData.Sprites[SPRITE_HalfHeartContainer]    = {.AtlasOffset = { 16, 64}, .SpriteSize = {11,  9}};
-    State->GameData.Sprites[SPRITE_EmptyHeartContainer]   = {.AtlasOffset = { 32, 64}, .SpriteSize = {11,  9}};
-    State->GameData.Sprites[SPRITE_TestEnemyUnit]         = {.AtlasOffset = { 16, 16}, .SpriteSize = {13, 11}};
-    State->GameData.Sprites[SPRITE_SelectionBox]          = {.AtlasOffset = {112, 16}, .SpriteSize = {16, 16}};
-    State->GameData.Sprites[SPRITE_Workbench]             = {.AtlasOffset = { 16, 80}, .SpriteSize = {16, 16}};
-    State->GameData.Sprites[SPRITE_Furnace]               = {.AtlasOffset = {  0, 80}, .SpriteSize = {16, 16}};
-    State->GameData.Sprites[SPRITE_Outline]               = {.AtlasOffset = {128,  0}, .SpriteSize = {16, 16}};
-
-    State->GameData.Sprites[SPRITE_Rock]                  = {.AtlasOffset = { 48, 35}, .SpriteSize = {16, 13}};
-    State->GameData.Sprites[SPRITE_Pebbles]               = {.AtlasOffset = { 48, 48}, .SpriteSize = {13, 12}};
-    State->GameData.Sprites[SPRITE_Tree00]                = {.AtlasOffset = { 96, 31}, .SpriteSize = {16, 17}};
-    State->GameData.Sprites[SPRITE_Branches]              = {.AtlasOffset = { 96, 48}, .SpriteSize = {12, 12}};
-    State->GameData.Sprites[SPRITE_Tree01]                = {.AtlasOffset = {130, 27}, .SpriteSize = {18, 21}};
-    State->GameData.Sprites[SPRITE_Trunk]                 = {.AtlasOffset = {128, 48}, .SpriteSize = {11, 11}};
-    State->GameData.Sprites[SPRITE_RubyOre]               = {.AtlasOffset = { 64, 35}, .SpriteSize = {16, 13}};
-    State->GameData.Sprites[SPRITE_RubyChunk]             = {.AtlasOffset = { 64, 48}, .SpriteSize = {13, 12}};
-    State->GameData.Sprites[SPRITE_SapphireOre]           = {.AtlasOffset = { 80, 35}, .SpriteSize = {16, 13}};
-    State->GameData.Sprites[SPRITE_SapphireChunk]         = {.AtlasOffset = { 80, 48}, .SpriteSize = {16, 13}};
+LoadSpriteData(gl_render_data *RenderData, game_state *State)
+{
+    State->GameData.Sprites[SPRITE_Nil]                 = GetAtlasSprite(RenderData, "Nil");
+    State->GameData.Sprites[SPRITE_Player]              = GetAtlasSprite(RenderData, "Player");
+    State->GameData.Sprites[SPRITE_UIItemBox]           = GetAtlasSprite(RenderData, "UIItemBox");
+    State->GameData.Sprites[SPRITE_ToolPickaxe]         = GetAtlasSprite(RenderData, "ToolPickaxe");
+    State->GameData.Sprites[SPRITE_ToolWoodAxe]         = GetAtlasSprite(RenderData, "ToolWoodAxe");
+    State->GameData.Sprites[SPRITE_FullHeartContainer]  = GetAtlasSprite(RenderData, "FullHeartContainer");
+    State->GameData.Sprites[SPRITE_HalfHeartContainer]  = GetAtlasSprite(RenderData, "HalfHeartContainer");
+    State->GameData.Sprites[SPRITE_EmptyHeartContainer] = GetAtlasSprite(RenderData, "EmptyHeartContainer");
+    State->GameData.Sprites[SPRITE_TestEnemyUnit]       = GetAtlasSprite(RenderData, "TestEnemyUnit");
+    State->GameData.Sprites[SPRITE_SelectionBox]        = GetAtlasSprite(RenderData, "SelectionBox");
+    State->GameData.Sprites[SPRITE_Workbench]           = GetAtlasSprite(RenderData, "Workbench");
+    State->GameData.Sprites[SPRITE_Furnace]             = GetAtlasSprite(RenderData, "Furnace");
+    State->GameData.Sprites[SPRITE_Outline]             = GetAtlasSprite(RenderData, "Outline");
+    State->GameData.Sprites[SPRITE_Rock]                = GetAtlasSprite(RenderData, "Rock");
+    State->GameData.Sprites[SPRITE_Pebbles]             = GetAtlasSprite(RenderData, "Pebbles");
+    State->GameData.Sprites[SPRITE_Tree00]              = GetAtlasSprite(RenderData, "Tree00");
+    State->GameData.Sprites[SPRITE_Branches]            = GetAtlasSprite(RenderData, "Branches");
+    State->GameData.Sprites[SPRITE_Tree01]              = GetAtlasSprite(RenderData, "Tree01");
+    State->GameData.Sprites[SPRITE_Trunk]               = GetAtlasSprite(RenderData, "Trunk");
+    State->GameData.Sprites[SPRITE_RubyOre]             = GetAtlasSprite(RenderData, "RubyOre");
+    State->GameData.Sprites[SPRITE_RubyChunk]           = GetAtlasSprite(RenderData, "RubyChunk");
+    State->GameData.Sprites[SPRITE_SapphireOre]         = GetAtlasSprite(RenderData, "SapphireOre");
+    State->GameData.Sprites[SPRITE_SapphireChunk]       = GetAtlasSprite(RenderData, "SapphireChunk");
+
+    State->GameData.SpriteAtlasGeneration = RenderData->SpriteAtlasGeneration;
 }
 
 internal inline void
@@ -262,33 +265,96 @@ LoadItemData(game_state *State)
     State->GameData.ItemSprites[ITEM_Furnace]          = MakePair(ITEM_Furnace,          SPRITE_Furnace);
 }
 
+internal inline entity *
+GetEntity(game_state *State, uint32 EntityIndex)
+{
+    return(&State->World.EntityPages[EntityIndex >> ENTITY_PAGE_SHIFT][EntityIndex & ENTITY_PAGE_MASK]);
+}
+
+internal bool
+AddEntityPage(game_state *State)
+{
+    bool Result = false;
+    uint32 PageLimit = (State->World.MaxEntityCount + ENTITY_PAGE_MASK) >> ENTITY_PAGE_SHIFT;
+    if(State->World.EntityPageCount < PageLimit)
+    {
+        entity *Page = (entity *)ArenaAlloc(State->World.EntityArena, sizeof(struct entity) * ENTITIES_PER_PAGE);
+        if(Page)
+        {
+            State->World.EntityPages[State->World.EntityPageCount++] = Page;
+            Result = true;
+        }
+    }
+    
+    return(Result);
+}
+
+// NOTE(Sleepster): Only allocates the first time through, hotreloading keeps the pages that are already there 
+internal void
+InitEntityStorage(game_memory *Memory, game_state *State)
+{
+    if(!State->World.EntityPageCount)
+    {
+        if(State->World.MaxEntityCount == 0)
+        {
+            State->World.MaxEntityCount = DEFAULT_ENTITY_CAPACITY;
+        }
+        if(State->World.MaxEntityCount > MAX_ENTITY_PAGES * ENTITIES_PER_PAGE)
+        {
+            State->World.MaxEntityCount = MAX_ENTITY_PAGES * ENTITIES_PER_PAGE;
+        }
+        
+        State->World.EntityArena = &Memory->PermanentStorage;
+        AddEntityPage(State);
+        
+        uint32 TimerCapacity = ((State->World.MaxEntityCount + ENTITY_PAGE_MASK) >> ENTITY_PAGE_SHIFT) * ENTITIES_PER_PAGE;
+        State->Timers.EntityTimers = (uint32 *)ArenaAlloc(&Memory->PermanentStorage, sizeof(uint32) * TimerCapacity);
+        State->Timers.EntityTimerCapacity = TimerCapacity;
+    }
+}
+
 internal entity *
 CreateEntity(game_state *State)
 {
     entity *Result = {};
     
-    for(uint32 EntityIndex = 1;
-        EntityIndex < MAX_ENTITIES;
-        ++EntityIndex)
+    uint32 EntityIndex = State->World.FirstFreeEntity ? State->World.FirstFreeEntity : 1;
+    for(;;)
     {
-        entity *Found = &State->World.Entities[EntityIndex]; 
+        if(EntityIndex >= State->World.EntityPageCount * ENTITIES_PER_PAGE && !AddEntityPage(State))
+        {
+            break;
+        }
+        
+        entity *Found = GetEntity(State, EntityIndex); 
         if(!(Found->Flags & IS_VALID))
         {
             Result = Found;
             Result->EntityID = EntityIndex;
             break;
         }
+        ++EntityIndex;
     }
     Assert(Result);
     
-    ++State->World.EntityCounter;
+    State->World.FirstFreeEntity = EntityIndex + 1;
+    if(EntityIndex >= State->World.EntityHighWater)
+    {
+        State->World.EntityHighWater = EntityIndex + 1;
+    }
+    
     Result->Flags = IS_VALID;
     return(Result);
 }
 
 internal inline void
-DeleteEntity(entity *Entity)
+DeleteEntity(game_state *State, entity *Entity)
 {
+    TimerCancelEntity(&State->Timers, Entity->EntityID);
+    if(uint32(Entity->EntityID) < State->World.FirstFreeEntity)
+    {
+        State->World.FirstFreeEntity = Entity->EntityID;
+    }
     memset(Entity, 0, sizeof(struct entity));
 }
 
@@ -661,11 +727,13 @@ SetupBuildingFurnace(game_state *State, entity *Entity)
 internal inline void
 ResetGame(gl_render_data *RenderData, game_state *State, game_memory *Memory)
 {
-    for(uint32 i = 0; i < MAX_ENTITIES; i++)
+    TimerWheelReset(&State->Timers);
+    for(uint32 PageIndex = 0; PageIndex < State->World.EntityPageCount; PageIndex++)
     {
-        entity *Temp = &State->World.Entities[i];
-        DeleteEntity(Temp);
+        memset(State->World.EntityPages[PageIndex], 0, sizeof(struct entity) * ENTITIES_PER_PAGE);
     }
+    State->World.EntityHighWater = 1;
+    State->World.FirstFreeEntity = 1;
     
     for(uint32 i = 0; i < SPRITE_Count; i++)
     {
@@ -743,20 +811,27 @@ CompareEntityYAxis(const void *A, const void *B)
            (EntityA->Position.Y < EntityB->Position.Y) ? -1 : 0);
 }
 
+internal inline const item *
+GetItemData(game_state *State, uint32 ItemID)
+{
+    return(&State->GameData.GameItems[ItemID]);
+}
+
 internal bool
-SwapInventoryItems(entity_item_inventory *Inventory, item *ItemA, item *ItemB)
+SwapInventoryItems(inventory_slot *SlotA, inventory_slot *SlotB)
 {   
-    item TempItem = *ItemA;
-    Inventory->Items[ItemA->OccupiedInventorySlot] = *ItemB;
-    Inventory->Items[ItemB->OccupiedInventorySlot] = TempItem;
+    inventory_slot TempSlot = *SlotA;
+    *SlotA = *SlotB;
+    *SlotB = TempSlot;
     
     return(true);
 }
 
 internal void
-SetupDroppedEntity(gl_render_data *RenderData, game_state *State, item *SelectionItem, entity *SpawnedItem)
+SetupDroppedEntity(gl_render_data *RenderData, game_state *State, uint32 ItemID, int32 StackCount, entity *SpawnedItem)
 {
-    switch(SelectionItem->Archetype)
+    const item *ItemData = GetItemData(State, ItemID);
+    switch(ItemData->Archetype)
     {
         case ARCH_Pebbles:
         {
@@ -797,7 +872,8 @@ SetupDroppedEntity(gl_render_data *RenderData, game_state *State, item *Selectio
     }
     
     SpawnedItem->Flags -= CAN_BE_PICKED_UP;
-    SpawnedItem->DroppedFromInventoryItemCount = SelectionItem->CurrentStack;
+    SpawnedItem->DroppedFromInventoryItemCount = StackCount;
+    TimerSchedule(&State->Timers, TIMER_ItemPickupReady, SpawnedItem->EntityID, ItemPickupDelayTicks);
     
     vec2 WorldMouseCoords = TransformMouseCoords(RenderData->GameCamera.ViewMatrix, RenderData->GameCamera.ProjectionMatrix, State->GameInput.Keyboard.CurrentMouse, SizeData);
     real32 Distance = fabsf(v2Distance(Player->Position, WorldMouseCoords));
@@ -816,6 +892,21 @@ SetupDroppedEntity(gl_render_data *RenderData, game_state *State, item *Selectio
     }
 }
 
+internal
+TIMER_CALLBACK(OnItemPickupReady)
+{
+    for(uint32 EventIndex = 0;
+        EventIndex < EventCount;
+        ++EventIndex)
+    {
+        entity *Item = GetEntity(State, Events[EventIndex].EntityID);
+        if((Item->Flags & IS_VALID) && (Item->Flags & IS_ITEM))
+        {
+            Item->Flags |= CAN_BE_PICKED_UP;
+        }
+    }
+}
+
 internal real32
 r32Clamp(real32 Value, real32 Min, real32 Max)
 {
@@ -832,16 +923,10 @@ v2Clamp(vec2 Value, vec2 Min, vec2 Max)
     return(Value);
 }
 
-internal void
-ResetItemSlotState(item *Item)
+internal inline void
+ResetItemSlotState(inventory_slot *Slot)
 {
-    Item->Sprite = {};
-    Item->CurrentStack = 0;
-    Item->ItemName = {};
-    Item->ItemDesc = {};
-    Item->ItemID   = {};
-    Item->MaxStackCount = {};
-    Item->Flags = {};
+    *Slot = {};
 }
 
 internal inline sprite_type
@@ -871,7 +956,7 @@ GetItemIDFromPair(game_state *State, sprite_type Sprite)
 }
 
 internal bool
-IsItemCraftable(int *ItemCounts, item *Craft)
+IsItemCraftable(int *ItemCounts, const item *Craft)
 {
     if(Craft->CraftingFormula)
     {
@@ -902,18 +987,18 @@ AddItemToPlayerInventory(game_state *State, entity *Player, entity *Temp)
         real32 ItemDistance = fabsf(v2Distance(Temp->Position, Player->Position));
         if(ItemDistance <= ItemPickupDist)
         {
+            const item *NewItem = GetItemData(State, Temp->DroppedFromInventoryItemID);
             for(uint32 InventoryIndex = 0;
                 InventoryIndex < TOTAL_INVENTORY_SIZE;
                 ++InventoryIndex)
             {
-                item NewItem = State->GameData.GameItems[Temp->DroppedFromInventoryItemID];
-                if(Player->Inventory.Items[InventoryIndex].ItemID == NewItem.ItemID && 
-                   Player->Inventory.Items[InventoryIndex].CurrentStack < 
-                   Player->Inventory.Items[InventoryIndex].MaxStackCount)
+                inventory_slot *Slot = &Player->Inventory.Items[InventoryIndex];
+                if(Slot->ItemID == NewItem->ItemID && 
+                   Slot->CurrentStack < NewItem->MaxStackCount)
                 {
-                    Player->Inventory.Items[InventoryIndex].CurrentStack++;
+                    Slot->CurrentStack++;
                     // NOTE(Sleepster): If two matching IDs are found, skip to the deletion 
-                    DeleteEntity(Temp);
+                    DeleteEntity(State, Temp);
                     return;
                 }
             }
@@ -922,17 +1007,17 @@ AddItemToPlayerInventory(game_state *State, entity *Player, entity *Temp)
                 InventoryIndex < TOTAL_INVENTORY_SIZE;
                 ++InventoryIndex)
             {
-                item NewItem = State->GameData.GameItems[Temp->DroppedFromInventoryItemID];
-                if(Player->Inventory.Items[InventoryIndex].ItemID == 0)
+                inventory_slot *Slot = &Player->Inventory.Items[InventoryIndex];
+                if(Slot->ItemID == ITEM_Nil)
                 {
-                    NewItem.CurrentStack = Temp->DroppedFromInventoryItemCount;
-                    if(NewItem.CurrentStack == 0)
+                    Slot->ItemID       = uint16(NewItem->ItemID);
+                    Slot->CurrentStack = int16(Temp->DroppedFromInventoryItemCount);
+                    Slot->Flags        = 0;
+                    if(Slot->CurrentStack == 0)
                     {
-                        NewItem.CurrentStack = 1;
+                        Slot->CurrentStack = 1;
                     }
-                    Player->Inventory.Items[InventoryIndex] = NewItem;
-                    Player->Inventory.Items[InventoryIndex].OccupiedInventorySlot = InventoryIndex;
-                    DeleteEntity(Temp);
+                    DeleteEntity(State, Temp);
                     break;
                 }
             }
@@ -940,13 +1025,375 @@ AddItemToPlayerInventory(game_state *State, entity *Player, entity *Temp)
     }
 }
 
+// NOTE(Sleepster): ENTITY SYSTEMS
+internal inline vec2
+GetSelectionBoxDrawSize(time Time)
+{
+    real32 BoxSize = SinBreatheNormalized(Time.CurrentTimeInSeconds, 0.5f, 13.0f, 15.0f);
+    return(vec2{BoxSize, BoxSize});
+}
+
+internal inline void
+UpdateDroppedItem(gl_render_data *RenderData, game_state *State, entity *Item, bool8 IsVisible, time Time)
+{
+    // NOTE(Sleepster): Only items still flying to their drop target touch their position, 
+    //                  the idle bob is done entirely in the vertex shader.
+    if(Item->Position.X != Item->Target.X || Item->Position.Y != Item->Target.Y)
+    {
+        v2Approach(&Item->Position, Item->Target, 5.0f, Time.Delta);
+    }
+    
+    if(IsVisible)
+    {
+        real32 BobPhase = real32(Item->EntityID) * 0.61803f * 2.0f * PI32;
+        DrawEntityAnimated(RenderData, State, Item, WHITE, vec3{BobPhase, ItemBobAmplitude, ItemBobFrequency});
+    }
+}
+
+internal inline void
+DrawWorldEntity(gl_render_data *RenderData, game_state *State, entity *Entity, vec2 SelectionBoxDrawSize)
+{
+    if(State->World.WorldFrame.SelectedEntity == Entity)
+    {
+        static_sprite_data SelectionBoxSprite = GetSprite(State, SPRITE_SelectionBox);
+        static_sprite_data EntitySprite = GetSprite(State, Entity->Sprite);
+        
+        DrawSprite(RenderData, 
+                   SelectionBoxSprite, 
+                   Entity->Position 
+                   - vec2{0, real32(EntitySprite.SpriteSize.Y * 0.25f)},
+                   SelectionBoxDrawSize, 
+                   WHITE, 
+                   0);
+    }
+    DrawEntity(RenderData, State, Entity, Entity->Position, WHITE);
+}
+
+// NOTE(Sleepster): Systems that do nothing but draw can split their span into jobs of this many entities
+constexpr uint32 ENTITY_DRAW_JOB_SIZE = 2048;
+constexpr uint32 MAX_ENTITY_DRAW_JOBS = 64;
+
+struct entity_draw_job
+{
+    game_state        *State;
+    entity           **Entities;
+    bool8             *Visible;
+    uint32             FirstEntity;
+    uint32             OnePastLastEntity;
+
+    uint32             SlabOffset;
+    quad_slab_writer   Writer;
+
+    entity            *SelectedEntity;
+    static_sprite_data SelectionBoxSprite;
+    vec2               SelectionBoxSize;
+};
+
+// NOTE(Sleepster): DrawWorldEntity for a piece of the span, only writes into its own part of the slab
+internal
+WORK_BATCH_CALLBACK(DrawWorldEntityJob)
+{
+    entity_draw_job *Job = &((entity_draw_job *)Data)[JobIndex];
+    for(uint32 EntityIndex = Job->FirstEntity;
+        EntityIndex < Job->OnePastLastEntity;
+        ++EntityIndex)
+    {
+        if(!Job->Visible[EntityIndex]) continue;
+
+        entity *Entity = Job->Entities[EntityIndex];
+        if(Entity == Job->SelectedEntity)
+        {
+            static_sprite_data EntitySprite = GetSprite(Job->State, Entity->Sprite);
+            DrawSlabSprite(&Job->Writer, 
+                           Job->SelectionBoxSprite, 
+                           Entity->Position 
+                           - vec2{0, real32(EntitySprite.SpriteSize.Y * 0.25f)},
+                           Job->SelectionBoxSize, 
+                           WHITE, 
+                           0);
+        }
+        DrawSlabEntity(&Job->Writer, Job->State, Entity, WHITE);
+    }
+}
+
+// NOTE(Sleepster): DrawWorldEntity over a whole span, split across the work queue. The main thread counts what each job
+//                  will draw and reserves one slab for all of it, so every quad lands at the submission index the plain
+//                  loop would have given it and the frame sorts out the same.
+internal void
+DrawWorldEntitySpan(gl_render_data *RenderData, game_state *State, entity **Entities, bool8 *Visible, uint32 EntityCount, vec2 SelectionBoxSize)
+{
+    if(EntityCount == 0) return;
+
+    entity *SelectedEntity = State->World.WorldFrame.SelectedEntity;
+    uint32  JobCount       = MIN((EntityCount + ENTITY_DRAW_JOB_SIZE - 1) / ENTITY_DRAW_JOB_SIZE, MAX_ENTITY_DRAW_JOBS);
+    uint32  JobSize        = (EntityCount + JobCount - 1) / JobCount;
+    entity_draw_job *Jobs  = (entity_draw_job *)ArenaAlloc(RenderData->FrameArena, sizeof(entity_draw_job) * JobCount);
+
+    uint32 QuadCount = 0;
+    for(uint32 JobIndex = 0;
+        JobIndex < JobCount;
+        ++JobIndex)
+    {
+        entity_draw_job *Job = &Jobs[JobIndex];
+        Job->State              = State;
+        Job->Entities           = Entities;
+        Job->Visible            = Visible;
+        Job->FirstEntity        = MIN(JobIndex * JobSize, EntityCount);
+        Job->OnePastLastEntity  = MIN(Job->FirstEntity + JobSize, EntityCount);
+        Job->SlabOffset         = QuadCount;
+        Job->SelectedEntity     = SelectedEntity;
+        Job->SelectionBoxSprite = GetSprite(State, SPRITE_SelectionBox);
+        Job->SelectionBoxSize   = SelectionBoxSize;
+
+        for(uint32 EntityIndex = Job->FirstEntity;
+            EntityIndex < Job->OnePastLastEntity;
+            ++EntityIndex)
+        {
+            if(Visible[EntityIndex])
+            {
+                QuadCount += (Entities[EntityIndex] == SelectedEntity) ? 2 : 1;
+            }
+        }
+    }
+    if(QuadCount == 0) return;
+
+    quad_slab Slab = ReserveQuadSlab(RenderData, QuadCount);
+    for(uint32 JobIndex = 0;
+        JobIndex < JobCount;
+        ++JobIndex)
+    {
+        Jobs[JobIndex].Writer = BeginQuadSlabWrite(&Slab, Jobs[JobIndex].SlabOffset);
+    }
+
+    RenderData->CloverRunWorkBatch(RenderData->WorkQueue, &State->World.EntityDrawBatch, DrawWorldEntityJob, Jobs, JobCount);
+}
+
+internal
+ENTITY_SYSTEM(EntitySystemPlayer)
+{
+    for(uint32 EntityIndex = 0;
+        EntityIndex < EntityCount;
+        ++EntityIndex)
+    {
+        entity *Temp = Entities[EntityIndex];
+        
+        Player = Temp;
+        HandleInput(State, Temp, Time);
+        RenderData->GameCamera.Target = Temp->Position;
+        
+        v2Approach(&RenderData->GameCamera.Position, RenderData->GameCamera.Target, 5.0f, Time.Delta);
+        DrawEntity(RenderData, State, Temp, Temp->Position, WHITE);
+    }
+}
+
+internal
+ENTITY_SYSTEM(EntitySystemDroppedItem)
+{
+    for(uint32 EntityIndex = 0;
+        EntityIndex < EntityCount;
+        ++EntityIndex)
+    {
+        UpdateDroppedItem(RenderData, State, Entities[EntityIndex], Visible[EntityIndex], Time);
+    }
+}
+
+internal
+ENTITY_SYSTEM(EntitySystemResource)
+{
+    DrawWorldEntitySpan(RenderData, State, Entities, Visible, EntityCount, GetSelectionBoxDrawSize(Time));
+}
+
+// NOTE(Sleepster): Buildings share their archetype with their dropped item form, so this one still has to check per entity 
+internal
+ENTITY_SYSTEM(EntitySystemBuilding)
+{
+    vec2 SelectionBoxDrawSize = GetSelectionBoxDrawSize(Time);
+    for(uint32 EntityIndex = 0;
+        EntityIndex < EntityCount;
+        ++EntityIndex)
+    {
+        entity *Temp = Entities[EntityIndex];
+        if(Temp->Flags & IS_ITEM)
+        {
+            UpdateDroppedItem(RenderData, State, Temp, Visible[EntityIndex], Time);
+        }
+        else if(Visible[EntityIndex])
+        {
+            DrawWorldEntity(RenderData, State, Temp, SelectionBoxDrawSize);
+        }
+    }
+}
+
+internal void
+RegisterEntitySystems(game_state *State)
+{
+    entity_system **Systems = State->GameData.EntityUpdateSystems;
+    for(uint32 ArchIndex = 0;
+        ArchIndex < ARCH_ID_MAX;
+        ++ArchIndex)
+    {
+        Systems[ArchIndex] = EntitySystemBuilding;
+    }
+    
+    Systems[ARCH_Player]           = EntitySystemPlayer;
+    
+    Systems[ARCH_Rock]             = EntitySystemResource;
+    Systems[ARCH_Tree00]           = EntitySystemResource;
+    Systems[ARCH_Tree01]           = EntitySystemResource;
+    Systems[ARCH_SapphireNode]     = EntitySystemResource;
+    Systems[ARCH_RubyNode]         = EntitySystemResource;
+    
+    Systems[ARCH_Workbench]        = EntitySystemBuilding;
+    Systems[ARCH_Furnace]          = EntitySystemBuilding;
+    
+    Systems[ARCH_Pebbles]          = EntitySystemDroppedItem;
+    Systems[ARCH_Branches]         = EntitySystemDroppedItem;
+    Systems[ARCH_Trunk]            = EntitySystemDroppedItem;
+    Systems[ARCH_SapphireOreChunk] = EntitySystemDroppedItem;
+    Systems[ARCH_RubyOreChunk]     = EntitySystemDroppedItem;
+    Systems[ARCH_SimplePickaxe]    = EntitySystemDroppedItem;
+    Systems[ARCH_SimpleWoodAxe]    = EntitySystemDroppedItem;
+}
+
+// NOTE(Sleepster): Bounds are packed SoA so the camera test runs four entities per SSE compare. Each entity gets a
+//                  square extent off its larger axis (plus EntityCullPadding) so rotation never clips it early.
+internal void
+CullEntitySpans(game_memory *Memory, range_v2 ViewBounds, entity **Spans, bool8 *Visible, uint32 Count)
+{
+    uint32  PackedCount = (Count + 3) & ~3u;
+    real32 *CenterX     = (real32 *)ArenaAlloc(&Memory->TemporaryStorage, sizeof(real32) * PackedCount);
+    real32 *CenterY     = (real32 *)ArenaAlloc(&Memory->TemporaryStorage, sizeof(real32) * PackedCount);
+    real32 *Extent      = (real32 *)ArenaAlloc(&Memory->TemporaryStorage, sizeof(real32) * PackedCount);
+    
+    for(uint32 SpanIndex = 0;
+        SpanIndex < Count;
+        ++SpanIndex)
+    {
+        entity *Temp = Spans[SpanIndex];
+        
+        // NOTE(Sleepster): Sprites are anchored at their bottom center
+        CenterX[SpanIndex] = Temp->Position.X;
+        CenterY[SpanIndex] = Temp->Position.Y + (Temp->Size.Y * 0.5f);
+        Extent[SpanIndex]  = (MAX(fabsf(Temp->Size.X), fabsf(Temp->Size.Y)) * 0.5f) + EntityCullPadding;
+    }
+    for(uint32 PadIndex = Count;
+        PadIndex < PackedCount;
+        ++PadIndex)
+    {
+        CenterX[PadIndex] = 0.0f;
+        CenterY[PadIndex] = 0.0f;
+        Extent[PadIndex]  = 0.0f;
+    }
+    
+    __m128 AbsMask     = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 ViewCenterX = _mm_set1_ps((ViewBounds.Min.X + ViewBounds.Max.X) * 0.5f);
+    __m128 ViewCenterY = _mm_set1_ps((ViewBounds.Min.Y + ViewBounds.Max.Y) * 0.5f);
+    __m128 ViewExtentX = _mm_set1_ps((ViewBounds.Max.X - ViewBounds.Min.X) * 0.5f);
+    __m128 ViewExtentY = _mm_set1_ps((ViewBounds.Max.Y - ViewBounds.Min.Y) * 0.5f);
+    for(uint32 PackIndex = 0;
+        PackIndex < PackedCount;
+        PackIndex += 4)
+    {
+        __m128 EntityExtent = _mm_loadu_ps(&Extent[PackIndex]);
+        __m128 DeltaX = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(&CenterX[PackIndex]), ViewCenterX), AbsMask);
+        __m128 DeltaY = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(&CenterY[PackIndex]), ViewCenterY), AbsMask);
+        
+        __m128 Inside = _mm_and_ps(_mm_cmple_ps(DeltaX, _mm_add_ps(EntityExtent, ViewExtentX)),
+                                   _mm_cmple_ps(DeltaY, _mm_add_ps(EntityExtent, ViewExtentY)));
+        int32 Mask = _mm_movemask_ps(Inside);
+        
+        uint32 LaneCount = MIN(4u, Count - PackIndex);
+        for(uint32 Lane = 0;
+            Lane < LaneCount;
+            ++Lane)
+        {
+            Visible[PackIndex + Lane] = bool8((Mask >> Lane) & 1);
+        }
+    }
+}
+
+internal void
+RunEntitySystems(game_memory *Memory, gl_render_data *RenderData, game_state *State, time Time)
+{
+    // NOTE(Sleepster): Counting sort the live entities by archetype so each system gets one contiguous span 
+    uint32 ArchCounts[ARCH_ID_MAX]  = {};
+    uint32 ArchOffsets[ARCH_ID_MAX] = {};
+    uint32 EntityLimit = State->World.EntityHighWater;
+    for(uint32 EntityIndex = 0;
+        EntityIndex < EntityLimit;
+        ++EntityIndex)
+    {
+        entity *Temp = GetEntity(State, EntityIndex);
+        if(Temp->Flags & IS_VALID)
+        {
+            ++ArchCounts[Temp->Archetype];
+        }
+    }
+    
+    uint32 TotalCount = 0;
+    for(uint32 ArchIndex = 0;
+        ArchIndex < ARCH_ID_MAX;
+        ++ArchIndex)
+    {
+        ArchOffsets[ArchIndex] = TotalCount;
+        TotalCount += ArchCounts[ArchIndex];
+    }
+    
+    entity **Spans = (entity **)ArenaAlloc(&Memory->TemporaryStorage, sizeof(entity *) * (TotalCount + 1));
+    uint32 WriteOffsets[ARCH_ID_MAX];
+    memcpy(WriteOffsets, ArchOffsets, sizeof(ArchOffsets));
+    for(uint32 EntityIndex = 0;
+        EntityIndex < EntityLimit;
+        ++EntityIndex)
+    {
+        entity *Temp = GetEntity(State, EntityIndex);
+        if(Temp->Flags & IS_VALID)
+        {
+            Spans[WriteOffsets[Temp->Archetype]++] = Temp;
+        }
+    }
+    
+    bool8 *Visible = (bool8 *)ArenaAlloc(&Memory->TemporaryStorage, sizeof(bool8) * (TotalCount + 1));
+    CullEntitySpans(Memory, RenderData->GameCamera.ViewBounds, Spans, Visible, TotalCount);
+    
+    for(uint32 ArchIndex = 0;
+        ArchIndex < ARCH_ID_MAX;
+        ++ArchIndex)
+    {
+        uint32 VisibleCount = 0;
+        for(uint32 SpanIndex = ArchOffsets[ArchIndex];
+            SpanIndex < ArchOffsets[ArchIndex] + ArchCounts[ArchIndex];
+            ++SpanIndex)
+        {
+            VisibleCount += Visible[SpanIndex];
+        }
+        
+        State->GameData.EntitySystemCycles[ArchIndex]  = 0;
+        State->GameData.EntitySystemCounts[ArchIndex]  = ArchCounts[ArchIndex];
+        State->GameData.EntitySystemVisible[ArchIndex] = VisibleCount;
+        
+        entity_system *System = State->GameData.EntityUpdateSystems[ArchIndex];
+        if(System && ArchCounts[ArchIndex])
+        {
+            uint64 StartCycles = __rdtsc();
+            System(RenderData, State, &Spans[ArchOffsets[ArchIndex]], &Visible[ArchOffsets[ArchIndex]], ArchCounts[ArchIndex], Time);
+            State->GameData.EntitySystemCycles[ArchIndex] = __rdtsc() - StartCycles;
+        }
+    }
+}
+
 extern
 GAME_ON_AWAKE(GameOnAwake)
 {
+    InitEntityStorage(Memory, State);
     ResetGame(RenderData, State, Memory);
-    LoadSpriteData(State);
+    LoadSpriteData(RenderData, State);
     LoadItemData(State);
 
+    // NOTE(Sleepster): These get re-registered every awake so they point into the freshly loaded DLL 
+    State->Timers.Callbacks[TIMER_ItemPickupReady] = OnItemPickupReady;
+    RegisterEntitySystems(State);
+
     // TODO(Sleepster): Write a proper implementation of Mini Audio's low level API so that 
     //                  hotreloading the engine doesn't just crash the program
     
@@ -1036,6 +1483,12 @@ extern
 GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
 {
     DrawImGui(State, RenderData, Time);
+
+    // NOTE(Sleepster): The platform layer repacked the sprite atlas, offsets may have moved
+    if(State->GameData.SpriteAtlasGeneration != RenderData->SpriteAtlasGeneration)
+    {
+        LoadSpriteData(RenderData, State);
+    }
     
     State->World.WorldFrame = {};
     
@@ -1056,6 +1509,9 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         RenderData->GameCamera.ProjectionMatrix       = mat4RHGLOrtho((real32)SizeData.Width * -0.5f, (real32)SizeData.Width * 0.5f, (real32)SizeData.Height * -0.5f, (real32)SizeData.Height * 0.5f, -1.0f, 1.0f); 
         RenderData->GameCamera.ProjectionViewMatrix   = mat4Multiply(RenderData->GameCamera.ProjectionMatrix, RenderData->GameCamera.ViewMatrix);        
         
+        vec2 HalfView = vec2{(real32)SizeData.Width * 0.5f, (real32)SizeData.Height * 0.5f} / RenderData->GameCamera.Zoom;
+        RenderData->GameCamera.ViewBounds = CreateRange(RenderData->GameCamera.Position - HalfView, RenderData->GameCamera.Position + HalfView);
+        
         // NOTE(Sleepster): UI
         RenderData->GameUICamera.ProjectionMatrix     = mat4RHGLOrtho((real32)SizeData.Width * -0.5f, (real32)SizeData.Width * 0.5f, (real32)SizeData.Height * -0.5f, (real32)SizeData.Height * 0.5f, -1.0f, 1.0f); 
         RenderData->GameUICamera.ViewMatrix           = mat4Multiply(mat4Identity(1.0f), ScaleMatrix);
@@ -1076,10 +1532,10 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
     real32 SelectionDistance = 32.0f;
     real32 MinimumDistance = 0;
     for(uint32 EntityIndex = 0;
-        EntityIndex <= State->World.EntityCounter;
+        EntityIndex < State->World.EntityHighWater;
         ++EntityIndex)
     {
-        entity *Temp = &State->World.Entities[EntityIndex];
+        entity *Temp = GetEntity(State, EntityIndex);
         if((Temp->Flags & IS_VALID))
         {
             real32 Distance = fabsf(v2Distance(Temp->Position, MouseToWorld));
@@ -1111,9 +1567,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                                 DropCount++)
                             {
                                 entity *CreatedEntity = CreateEntity(State);
-                                item DroppedItem = State->GameData.GameItems[Temp->EntityDrops[DropCount].DroppedItem];
-
-                                SetupDroppedEntity(RenderData, State, &DroppedItem, CreatedEntity);
+                                SetupDroppedEntity(RenderData, State, Temp->EntityDrops[DropCount].DroppedItem, 0, CreatedEntity);
                                 CreatedEntity->Position = Temp->Position;
                                 CreatedEntity->Target   = Temp->Position;
                             }
@@ -1121,7 +1575,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
 
                         //PlaySound(&Memory->TemporaryStorage, State, STR("boop.wav"), 1);
                         State->World.WorldFrame.SelectedEntity = {};
-                        DeleteEntity(Temp);
+                        DeleteEntity(State, Temp);
                     }
                 }
             }
@@ -1136,6 +1590,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         State->UIContext.UICameraViewMatrix       = RenderData->GameUICamera.ViewMatrix;
         State->UIContext.UICameraProjectionMatrix = RenderData->GameUICamera.ProjectionMatrix;
         State->UIContext.GameInput                = &State->GameInput;
+        State->UIContext.RenderData               = RenderData;
         State->UIContext.ActiveFont               = &RenderData->LoadedFonts[UBUNTU_MONO];
         State->UIContext.ActiveFontIndex          = UBUNTU_MONO;
         
@@ -1152,13 +1607,8 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         {
             real32 SlotOffset = (IconSize + Padding) * InventorySlot;
             
-            mat4 XForm = mat4Identity(1.0f);
-            XForm = mat4Multiply(XForm, mat4Translate(vec3{StartingX + SlotOffset, YOffset, 0.0}));
-            XForm = mat4Multiply(XForm, mat4Translate(vec3{IconSize * -0.55f, 0.0f, 0.0f}));
-            XForm = mat4Multiply(XForm, mat4MakeScale(vec3{IconSize, IconSize, 1.0}));
-            
-            vec4 MatrixPosition = XForm.Columns[3];
-            vec2 SlotPosition   = {MatrixPosition.X, MatrixPosition.Y};
+            affine2d XForm = affine2dMakeTRS(vec2{StartingX + SlotOffset + (IconSize * -0.55f), YOffset}, 0.0f, vec2{IconSize, IconSize});
+            vec2 SlotPosition = XForm.Offset;
             
             static_sprite_data Sprite = GetSprite(State, SPRITE_UIItemBox);
             ui_element_state HotbarSlotState = CloverUIButton(&State->UIContext, STR("HotbarSlot"), SlotPosition, {IconSize, IconSize}, Sprite, WHITE);
@@ -1170,20 +1620,20 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             HotbarSlot->Sprite = Sprite;
             HotbarSlot->DrawColor = WHITE;
             
-            item *Item = &Player->Inventory.Items[InventorySlot];
-            Item->OccupiedInventorySlot = InventorySlot;
+            inventory_slot *Item = &Player->Inventory.Items[InventorySlot];
+            const item *ItemData = GetItemData(State, Item->ItemID);
             
-            Sprite = GetSprite(State, Item->Sprite);
+            Sprite = GetSprite(State, ItemData->Sprite);
             if(Sprite != State->GameData.Sprites[SPRITE_Nil])
             {
                 if(!HotbarSlotState.IsHot)
                 {
-                    XForm = mat4Multiply(XForm, mat4MakeScale(vec3{0.65, 0.65, 1.0}));
+                    XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{0.65f, 0.65f}));
                 }
                 
                 if(InventorySlot == Player->Inventory.CurrentInventorySlot)
                 {
-                    XForm = mat4Multiply(XForm, mat4MakeScale(vec3{1.2, 1.2, 1.0}));
+                    XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1.2f, 1.2f}));
                 }
                 DrawUISpriteXForm(RenderData, XForm, Sprite, 0, WHITE);
             }
@@ -1191,9 +1641,9 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             if(HotbarSlotState.IsHot)
             {
                 HotbarSlot->DrawColor = RED;
-                if(Item->Sprite != SPRITE_Nil)
+                if(ItemData->Sprite != SPRITE_Nil)
                 {
-                    XForm = mat4Multiply(XForm, mat4MakeScale(vec3{0.8, 0.8, 1.0}));
+                    XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{0.8f, 0.8f}));
                     
                     real32 NewUIYOffset;
                     real32 NewUIYDescOffset;
@@ -1213,41 +1663,37 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                     
                     vec2 UIBoxSize = {10, 25};
                     
-                    mat4 UIXForm = mat4Identity(1.0f);
-                    UIXForm = mat4Multiply(UIXForm, mat4Translate(vec3{StartingX + SlotOffset, YOffset, 0.0}));
-                    UIXForm = mat4Multiply(UIXForm, mat4Translate(vec3{IconSize * -0.55f, NewUIYOffset, 0.0f}));
+                    affine2d UIXForm = affine2dMakeTRS(vec2{StartingX + SlotOffset + (IconSize * -0.55f), YOffset + NewUIYOffset}, 0.0f, vec2{1.0f, 1.0f});
                     
                     // NOTE(Sleepster): String Size to influence the BosSize
-                    vec4 UIMatrixPosition = UIXForm.Columns[3];
-                    vec2 Position = vec2{UIMatrixPosition.X, UIMatrixPosition.Y};
+                    vec2 Position = UIXForm.Offset;
                     
-                    static_sprite_data SpriteData = GetSprite(State, Item->Sprite);
+                    static_sprite_data SpriteData = GetSprite(State, ItemData->Sprite);
                     
-                    ui_element *ItemDescData = CloverUIMakeTextElement(&State->UIContext, Item->ItemDesc, {Position.X, Position.Y + NewUIYDescOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
-                    CloverUIMakeTextElement(&State->UIContext, Item->ItemName, {Position.X + 4, Position.Y + NewUIYOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
+                    ui_element *ItemDescData = CloverUIMakeTextElement(&State->UIContext, ItemData->ItemDesc, {Position.X, Position.Y + NewUIYDescOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
+                    CloverUIMakeTextElement(&State->UIContext, ItemData->ItemName, {Position.X + 4, Position.Y + NewUIYOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
                     
-                    mat4 SpriteXForm = UIXForm;
-                    UIXForm = mat4Multiply(UIXForm, mat4Translate(vec3{0, NewUIYOffset, 0}));
-                    UIXForm = mat4Multiply(UIXForm, mat4MakeScale(v2Expand(UIBoxSize + ItemDescData->Size, 1.0f)));
+                    affine2d SpriteXForm = UIXForm;
+                    UIXForm = affine2dMultiply(UIXForm, affine2dMakeTRS(vec2{0, NewUIYOffset}, 0.0f, vec2{1.0f, 1.0f}));
+                    UIXForm = affine2dMultiply(UIXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, UIBoxSize + ItemDescData->Size));
                     DrawUISpriteXForm(RenderData, UIXForm, GetSprite(State, SPRITE_Nil), 0, vec4{0.2f, 0.2f, 0.2f, 0.2f});
                     
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{UIBoxSize.X + ItemDescData->Size.X * -0.5f, SpriteYOffset, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{IconSize, IconSize, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{UIBoxSize.X + ItemDescData->Size.X * -0.5f, SpriteYOffset}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{IconSize, IconSize}));
                     DrawUISpriteXForm(RenderData, SpriteXForm, SpriteData, 0, WHITE);
                     
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{1 / IconSize, 1 / IconSize, 1.0f}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{-(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 0, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 19, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{-7, 0, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{16, 16, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1 / IconSize, 1 / IconSize}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{-(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 0}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 19}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{-7, 0}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{16, 16}));
                     DrawUISpriteXForm(RenderData, SpriteXForm, GetSprite(State, SPRITE_Nil), 0, vec4{0.1f, 0.1f, 0.1f, 0.4f});
                     
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{1 / IconSize, 1 / IconSize, 1.0f}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{2, -6, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{16, 16, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1 / IconSize, 1 / IconSize}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{2, -6}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{16, 16}));
                     
-                    vec4 ItemCountTextPosition = SpriteXForm.Columns[3];
-                    Position = vec2{ItemCountTextPosition.X, ItemCountTextPosition.Y};
+                    Position = SpriteXForm.Offset;
                     CloverUIMakeTextElement(&State->UIContext, sprints(&Memory->TemporaryStorage, STR("x%d"), Item->CurrentStack), {Position.X + 3, Position.Y}, 15, TEXT_ALIGNMENT_Center, GREEN);
                 }
             }
@@ -1255,7 +1701,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             // SELECTED INVENTORY ITEM
             if(HotbarSlot->IsActive)
             {
-                if(Item->Sprite != SPRITE_Nil && !Player->Inventory.SelectedInventoryItem)
+                if(ItemData->Sprite != SPRITE_Nil && !Player->Inventory.SelectedInventoryItem)
                 {
                     Player->Inventory.SelectedInventoryItem = Item;
                 }
@@ -1276,6 +1722,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         State->UIContext.UICameraViewMatrix       = RenderData->GameUICamera.ViewMatrix;
         State->UIContext.UICameraProjectionMatrix = RenderData->GameUICamera.ProjectionMatrix;
         State->UIContext.GameInput                = &State->GameInput;
+        State->UIContext.RenderData               = RenderData;
         State->UIContext.ActiveFont               = &RenderData->LoadedFonts[UBUNTU_MONO];
         State->UIContext.ActiveFontIndex          = UBUNTU_MONO;
         
@@ -1291,13 +1738,8 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         {
             real32 SlotOffset = (IconSize + Padding) * (InventorySlot - 6);
             
-            mat4 XForm = mat4Identity(1.0f);
-            XForm = mat4Multiply(XForm, mat4Translate(vec3{StartingX + SlotOffset, InventoryYOffset, 0.0}));
-            XForm = mat4Multiply(XForm, mat4Translate(vec3{IconSize * -0.55f, 0.0f, 0.0f}));
-            XForm = mat4Multiply(XForm, mat4MakeScale(vec3{IconSize, IconSize, 1.0}));
-            
-            vec4 MatrixPosition = XForm.Columns[3];
-            vec2 SlotPosition   = {MatrixPosition.X, MatrixPosition.Y};
+            affine2d XForm = affine2dMakeTRS(vec2{StartingX + SlotOffset + (IconSize * -0.55f), InventoryYOffset}, 0.0f, vec2{IconSize, IconSize});
+            vec2 SlotPosition = XForm.Offset;
             
             static_sprite_data Sprite = GetSprite(State, SPRITE_UIItemBox);
             ui_element_state HotbarSlotState = CloverUIButton(&State->UIContext, STR("InventorySlot"), SlotPosition, {IconSize, IconSize}, Sprite, WHITE);
@@ -1309,22 +1751,22 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             HotbarSlot->Sprite = Sprite;
             HotbarSlot->DrawColor = WHITE;
             
-            item *Item = &Player->Inventory.Items[InventorySlot];
-            Item->OccupiedInventorySlot = InventorySlot;
+            inventory_slot *Item = &Player->Inventory.Items[InventorySlot];
+            const item *ItemData = GetItemData(State, Item->ItemID);
             
-            Sprite = GetSprite(State, Item->Sprite);
+            Sprite = GetSprite(State, ItemData->Sprite);
             if(Sprite != State->GameData.Sprites[SPRITE_Nil] && !HotbarSlotState.IsHot)
             {
-                XForm = mat4Multiply(XForm, mat4MakeScale(vec3{0.65, 0.65, 1.0}));
+                XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{0.65f, 0.65f}));
                 DrawUISpriteXForm(RenderData, XForm, Sprite, 0, WHITE);
             }
             
             if(HotbarSlotState.IsHot)
             {
                 HotbarSlot->DrawColor = RED;
-                if(Item->Sprite != SPRITE_Nil)
+                if(ItemData->Sprite != SPRITE_Nil)
                 {
-                    XForm = mat4Multiply(XForm, mat4MakeScale(vec3{1.0, 1.0, 1.0}));
+                    XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1.0f, 1.0f}));
                     DrawUISpriteXForm(RenderData, XForm, Sprite, 0, WHITE);
                     
                     real32 NewUIYOffset;
@@ -1345,40 +1787,36 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                     
                     vec2 UIBoxSize = {10, 25};
                     
-                    mat4 UIXForm = mat4Identity(1.0f);
-                    UIXForm = mat4Multiply(UIXForm, mat4Translate(vec3{StartingX + SlotOffset, -90, 0.0}));
-                    UIXForm = mat4Multiply(UIXForm, mat4Translate(vec3{IconSize * -0.55f, NewUIYOffset, 0.0f}));
+                    affine2d UIXForm = affine2dMakeTRS(vec2{StartingX + SlotOffset + (IconSize * -0.55f), -90 + NewUIYOffset}, 0.0f, vec2{1.0f, 1.0f});
                     
-                    vec4 UIMatrixPosition = UIXForm.Columns[3];
-                    vec2 Position = vec2{UIMatrixPosition.X, UIMatrixPosition.Y};
+                    vec2 Position = UIXForm.Offset;
                     
-                    static_sprite_data SpriteData = GetSprite(State, Item->Sprite);
+                    static_sprite_data SpriteData = GetSprite(State, ItemData->Sprite);
                     
-                    ui_element *ItemDescData = CloverUIMakeTextElement(&State->UIContext, Item->ItemDesc, {Position.X, Position.Y + NewUIYDescOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
-                    CloverUIMakeTextElement(&State->UIContext, Item->ItemName, {Position.X + 4, Position.Y + NewUIYOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
+                    ui_element *ItemDescData = CloverUIMakeTextElement(&State->UIContext, ItemData->ItemDesc, {Position.X, Position.Y + NewUIYDescOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
+                    CloverUIMakeTextElement(&State->UIContext, ItemData->ItemName, {Position.X + 4, Position.Y + NewUIYOffset}, 10, TEXT_ALIGNMENT_Center, GREEN);
                     
-                    mat4 SpriteXForm = UIXForm;
-                    UIXForm = mat4Multiply(UIXForm, mat4Translate(vec3{0, NewUIYOffset, 0}));
-                    UIXForm = mat4Multiply(UIXForm, mat4MakeScale(v2Expand(UIBoxSize + ItemDescData->Size, 1.0f)));
+                    affine2d SpriteXForm = UIXForm;
+                    UIXForm = affine2dMultiply(UIXForm, affine2dMakeTRS(vec2{0, NewUIYOffset}, 0.0f, vec2{1.0f, 1.0f}));
+                    UIXForm = affine2dMultiply(UIXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, UIBoxSize + ItemDescData->Size));
                     DrawUISpriteXForm(RenderData, UIXForm, GetSprite(State, SPRITE_Nil), 0, vec4{0.2f, 0.2f, 0.2f, 0.2f});
                     
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{UIBoxSize.X + ItemDescData->Size.X * -0.5f, SpriteYOffset, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{IconSize, IconSize, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{UIBoxSize.X + ItemDescData->Size.X * -0.5f, SpriteYOffset}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{IconSize, IconSize}));
                     DrawUISpriteXForm(RenderData, SpriteXForm, SpriteData, 0, WHITE);
                     
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{1 / IconSize, 1 / IconSize, 1.0f}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{-(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 0, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 19, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{-7, 0, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{16, 16, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1 / IconSize, 1 / IconSize}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{-(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 0}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{(UIBoxSize.X + ItemDescData->Size.X * -0.5f), 19}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{-7, 0}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{16, 16}));
                     DrawUISpriteXForm(RenderData, SpriteXForm, GetSprite(State, SPRITE_Nil), 0, vec4{0.1f, 0.1f, 0.1f, 0.4f});
                     
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{1 / IconSize, 1 / IconSize, 1.0f}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4Translate(vec3{2, -6, 0}));
-                    SpriteXForm = mat4Multiply(SpriteXForm, mat4MakeScale(vec3{16, 16, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1 / IconSize, 1 / IconSize}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{2, -6}, 0.0f, vec2{1.0f, 1.0f}));
+                    SpriteXForm = affine2dMultiply(SpriteXForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{16, 16}));
                     
-                    vec4 ItemCountTextPosition = SpriteXForm.Columns[3];
-                    Position = vec2{ItemCountTextPosition.X, ItemCountTextPosition.Y};
+                    Position = SpriteXForm.Offset;
                     CloverUIMakeTextElement(&State->UIContext, sprints(&Memory->TemporaryStorage, STR("x%d"), Item->CurrentStack), {Position.X + 3, Position.Y}, 15, TEXT_ALIGNMENT_Center, GREEN);
                 }
             }
@@ -1390,7 +1828,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         InventoryIndexSlot < TOTAL_INVENTORY_SIZE;
         InventoryIndexSlot++)
     {
-        item *Item = &Player->Inventory.Items[InventoryIndexSlot];
+        inventory_slot *Item = &Player->Inventory.Items[InventoryIndexSlot];
         ui_element *InventoryElement = Player->Inventory.InventorySlotButtons[InventoryIndexSlot]; 
         if(Item->CurrentStack == 0 && InventoryIndexSlot == Player->Inventory.CurrentInventorySlot)
         {
@@ -1402,7 +1840,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             // NOTE(Sleepster): Inventory Item Selection first item 
             if(InventoryElement->IsActive)
             {
-                if(Item->Sprite != SPRITE_Nil && !Player->Inventory.SelectedInventoryItem)
+                if(Item->ItemID != ITEM_Nil && !Player->Inventory.SelectedInventoryItem)
                 {
                     Player->Inventory.SelectedInventoryItem = Item;
                 }
@@ -1411,39 +1849,39 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             // TODO(Sleepster): Render the Item count if it's needed 
             /* if(Item->CurrentStack > 1 && Item->MaxStackCount > 1) */
             /* { */
-            /*     mat4 TextXForm = InventoryElement->XForm; */
-            /*     vec2 TextPosition = TextXForm.Columns[3].XY; */
+            /*     affine2d TextXForm = InventoryElement->XForm; */
+            /*     vec2 TextPosition = TextXForm.Offset; */
             /*     DrawUIText(RenderData, sprints(&Memory->TemporaryStorage, STR("x%d"), Item->CurrentStack), {TextPosition.X, TextPosition.Y}, 10, UBUNTU_MONO, GREEN); */
             /* } */ 
             
             // NOTE(Sleepster): Scale sprite if selected 
             if(InventoryIndexSlot == Player->Inventory.CurrentInventorySlot)
             {
-                InventoryElement->XForm = mat4Multiply(InventoryElement->XForm, mat4MakeScale(vec3{1.20f, 1.20f, 1.0f}));
+                InventoryElement->XForm = affine2dMultiply(InventoryElement->XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, vec2{1.20f, 1.20f}));
             }
             
             // NOTE(Sleepster): Choose selection 
-            if((Player->Inventory.SelectedInventoryItem && Player->Inventory.SelectedInventoryItem->Sprite != SPRITE_Nil))
+            if((Player->Inventory.SelectedInventoryItem && Player->Inventory.SelectedInventoryItem->ItemID != ITEM_Nil))
             {
-                item *Selection = Player->Inventory.SelectedInventoryItem;
+                inventory_slot *Selection = Player->Inventory.SelectedInventoryItem;
                 vec2 MousePos = TransformMouseCoords(RenderData->GameUICamera.ViewMatrix, 
                                                      RenderData->GameUICamera.ProjectionMatrix, 
                                                      State->GameInput.Keyboard.CurrentMouse, 
                                                      SizeData);
                 
-                static_sprite_data SelectionSprite = GetSprite(State, Selection->Sprite);
+                static_sprite_data SelectionSprite = GetSprite(State, GetItemData(State, Selection->ItemID)->Sprite);
                 
                 CloverUIPushLayer(&State->UIContext, 1);
-                CloverUISpriteElement(&State->UIContext, MousePos + vec2{1, 0}, v2Cast(SelectionSprite.SpriteSize), NULLMATRIX, SelectionSprite, WHITE);
+                CloverUISpriteElement(&State->UIContext, MousePos + vec2{1, 0}, v2Cast(SelectionSprite.SpriteSize), {}, SelectionSprite, WHITE);
                 CloverUIPushLayer(&State->UIContext, 0);
                 
                 // NOTE(Sleepster): Dropping Selected inventory Items 
                 if(IsGameKeyPressed(DROP_ITEM, &State->GameInput))
                 {
                     entity *SpawnedItem = CreateEntity(State);
-                    SetupDroppedEntity(RenderData, State, Selection, SpawnedItem);
+                    SetupDroppedEntity(RenderData, State, Selection->ItemID, Selection->CurrentStack, SpawnedItem);
                     
-                    Player->Inventory.Items[Player->Inventory.SelectedInventoryItem->OccupiedInventorySlot] = {};
+                    ResetItemSlotState(Selection);
                     Player->Inventory.SelectedInventoryItem = {};
                 }
             }
@@ -1451,8 +1889,8 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             // NOTE(Sleepster): Swap item stuff 
             if(!Player->Inventory.SwapItem)
             {
-                item *Check = &Player->Inventory.Items[InventoryIndexSlot];
-                if(InventoryElement->IsActive && Player->Inventory.SelectedInventoryItem && Check->OccupiedInventorySlot != Player->Inventory.SelectedInventoryItem->OccupiedInventorySlot)
+                inventory_slot *Check = &Player->Inventory.Items[InventoryIndexSlot];
+                if(InventoryElement->IsActive && Player->Inventory.SelectedInventoryItem && Check != Player->Inventory.SelectedInventoryItem)
                 {
                     Player->Inventory.SwapItem = Check;
                 }
@@ -1461,7 +1899,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             // NOTE(Sleepster): Actually swapping the two 
             if(Player->Inventory.SwapItem && Player->Inventory.SelectedInventoryItem)
             {
-                SwapInventoryItems(&Player->Inventory, Player->Inventory.SelectedInventoryItem, Player->Inventory.SwapItem); 
+                SwapInventoryItems(Player->Inventory.SelectedInventoryItem, Player->Inventory.SwapItem); 
                 Player->Inventory.SwapItem = {};
                 Player->Inventory.SelectedInventoryItem = {};
             }
@@ -1471,7 +1909,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
     // NOTE(Sleepster): Quickdropping HotbarItem
     if(IsGameKeyPressed(DROP_HELD, &State->GameInput))
     {
-        item *HotbarItem = Player->Inventory.SelectedHotbarItem;
+        inventory_slot *HotbarItem = Player->Inventory.SelectedHotbarItem;
         if(HotbarItem && Player->Inventory.CurrentInventorySlot != NULLSLOT)
         {
             if(HotbarItem->CurrentStack != 0)
@@ -1483,7 +1921,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                         ItemCount++)
                     {
                         entity *DroppedEntity = CreateEntity(State);
-                        SetupDroppedEntity(RenderData, State, HotbarItem, DroppedEntity);
+                        SetupDroppedEntity(RenderData, State, HotbarItem->ItemID, HotbarItem->CurrentStack, DroppedEntity);
                         HotbarItem->CurrentStack = 0;
                     }
                 }
@@ -1491,7 +1929,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                 {
                     --HotbarItem->CurrentStack;
                     entity *DroppedEntity = CreateEntity(State);
-                    SetupDroppedEntity(RenderData, State, HotbarItem, DroppedEntity);
+                    SetupDroppedEntity(RenderData, State, HotbarItem->ItemID, HotbarItem->CurrentStack, DroppedEntity);
                     DroppedEntity->DroppedFromInventoryItemCount = 1;
                 }
             }
@@ -1515,26 +1953,25 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             const real32 StartingXOffset = -IconSize * 2;
             
             int IconCount = 0;
-            mat4 XForm = mat4Identity(1.0f);
+            affine2d XForm = affine2dIdentity();
             for(uint32 Element = 0;
                 Element < ITEM_IDCount;
                 Element++)
             {
-                item *Item = &State->GameData.GameItems[Element];
+                const item *Item = GetItemData(State, Element);
                 if(Item && Item->Flags & IS_BUILDABLE)
                 {
                     real32 NewXOffset = StartingXOffset + ((IconSize + Padding) * IconCount);
-                    XForm = mat4Identity(1.0f);
-                    XForm = mat4Translation(XForm, vec3{NewXOffset, 10, 0});
+                    XForm = affine2dMakeTRS(vec2{NewXOffset, 10}, 0.0f, vec2{1.0f, 1.0f});
                     
                     vec2 SpriteSize = {IconSize, IconSize};
                     if(State->ActiveBlueprint && Item->ItemID == State->ActiveBlueprint->ItemID)
                     {
                         SpriteSize = {14, 14};
                     }
-                    XForm = mat4Scale(XForm, v2Expand(SpriteSize, 1));
+                    XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, SpriteSize));
                     CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, Item->Sprite), WHITE);
-                    vec2 Position = XForm.Columns[3].XY;
+                    vec2 Position = XForm.Offset;
                     
                     CloverUIPushLayer(&State->UIContext, 1);
                     ui_element_state Button = CloverUIButton(&State->UIContext, STR("Element"), Position, SpriteSize, GetSprite(State, SPRITE_Outline), WHITE);
@@ -1555,13 +1992,11 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             vec2 BoxPosition = {0, 0};
             if(State->ActiveBlueprint)
             {
-                item *Item = State->ActiveBlueprint;
+                const item *Item = State->ActiveBlueprint;
                 BoxHeight = 115;
                 BoxPosition = {0, -20};
                 
-                XForm = mat4Identity(1.0f);
-                XForm = mat4Multiply(XForm, mat4Translate(v2Expand({BoxPosition.X, BoxPosition.Y + 20}, 0)));
-                XForm = mat4Multiply(XForm, mat4MakeScale(vec3{BoxWidth, 2, 1}));
+                XForm = affine2dMakeTRS(vec2{BoxPosition.X, BoxPosition.Y + 20}, 0.0f, vec2{BoxWidth, 2});
                 
                 CloverUIPushLayer(&State->UIContext, 1);
                 DrawUISpriteXForm(RenderData, XForm, GetSprite(State, SPRITE_Nil), 0, vec4{0.0, 0.0, 0.0, 0.8f});
@@ -1572,12 +2007,12 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                     InventorySlotIndex < TOTAL_INVENTORY_SIZE;
                     InventorySlotIndex++)
                 {
-                    item *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
+                    inventory_slot *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
                     for(int32 FormulaIndex = 0;
                         FormulaIndex < State->ActiveBlueprint->UniqueMaterialCount;
                         ++FormulaIndex)
                     {
-                        crafting_material *FormulaItem = &State->ActiveBlueprint->CraftingFormula[FormulaIndex];
+                        const crafting_material *FormulaItem = &State->ActiveBlueprint->CraftingFormula[FormulaIndex];
                         if(InventoryItem->ItemID == FormulaItem->CraftingMaterial)
                         {
                             InventoryCount[FormulaIndex] = InventoryItem->CurrentStack;
@@ -1589,17 +2024,13 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                     MaterialIndex < Item->UniqueMaterialCount;
                     MaterialIndex++)
                 {
-                    crafting_material *Material = &Item->CraftingFormula[MaterialIndex];
+                    const crafting_material *Material = &Item->CraftingFormula[MaterialIndex];
                     real32 NewYOffset = InitialYOffset - ((14 + Padding) * MaterialIndex);
                     
-                    XForm = mat4Identity(1.0f);
-                    XForm = mat4Translation(XForm, vec3{0, NewYOffset + 10, 0});
-                    XForm = mat4Scale(XForm, vec3{30, 12, 1});
+                    XForm = affine2dMakeTRS(vec2{0, NewYOffset + 10}, 0.0f, vec2{30, 12});
                     CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, SPRITE_Nil), {0.4, 0.4, 0.4, 0.3});
                     
-                    XForm = mat4Identity(1.0f);
-                    XForm = mat4Translation(XForm, vec3{-10, NewYOffset + 10, 0});
-                    XForm = mat4Scale(XForm, vec3{8, 8, 1});
+                    XForm = affine2dMakeTRS(vec2{-10, NewYOffset + 10}, 0.0f, vec2{8, 8});
                     
                     static_sprite_data Sprite = GetSprite(State, GetSpriteFromPair(State, Material->CraftingMaterial));
                     
@@ -1633,12 +2064,12 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                             InventorySlotIndex < TOTAL_INVENTORY_SIZE;
                             InventorySlotIndex++)
                         {
-                            item *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
+                            inventory_slot *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
                             for(int32 FormulaIndex = 0;
                                 FormulaIndex < State->ActiveBlueprint->UniqueMaterialCount;
                                 ++FormulaIndex)
                             {
-                                crafting_material *FormulaItem = &State->ActiveBlueprint->CraftingFormula[FormulaIndex];
+                                const crafting_material *FormulaItem = &State->ActiveBlueprint->CraftingFormula[FormulaIndex];
                                 if(InventoryItem->ItemID == FormulaItem->CraftingMaterial)
                                 {
                                     InventoryItem->CurrentStack -= FormulaItem->RequiredCount;
@@ -1675,9 +2106,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             {
                 BoxPosition = {0, 12.5};
             }
-            XForm = mat4Identity(1.0f);
-            XForm = mat4Multiply(XForm, mat4Translate(v2Expand(BoxPosition, 0)));
-            XForm = mat4Multiply(XForm, mat4MakeScale(vec3{BoxWidth, BoxHeight, 1}));
+            XForm = affine2dMakeTRS(BoxPosition, 0.0f, vec2{BoxWidth, BoxHeight});
             
             DrawUISpriteXForm(RenderData, XForm, GetSprite(State, SPRITE_Nil), 0, vec4{0.0, 0.0, 0.0, 0.8f});
             DrawUIText(RenderData, STR("Building..."), {-IconSize, 20}, 15, UBUNTU_MONO, WHITE);
@@ -1686,9 +2115,9 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         // NOTE(Sleepster): Building From Inventory/Hotbar
         if((Player->Inventory.SelectedHotbarItem || Player->Inventory.SelectedInventoryItem) && (Player->Inventory.CurrentInventorySlot != NULLSLOT))
         {
-            item *InventoryItem = {};
-            item *HotbarItem = {};
-            item *Item = {};
+            inventory_slot *InventoryItem = {};
+            inventory_slot *HotbarItem = {};
+            inventory_slot *Item = {};
             for(uint32 InventoryIndex = 0;
                 InventoryIndex < TOTAL_INVENTORY_SIZE;
                 InventoryIndex++)
@@ -1706,24 +2135,23 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                 };
             }
             
-            if((HotbarItem && (HotbarItem->Flags & IS_BUILDABLE)) || (InventoryItem && (InventoryItem->Flags & IS_BUILDABLE)))
+            if((HotbarItem && (GetItemData(State, HotbarItem->ItemID)->Flags & IS_BUILDABLE)) || 
+               (InventoryItem && (GetItemData(State, InventoryItem->ItemID)->Flags & IS_BUILDABLE)))
             {
                 vec2 MousePosition = RoundToTile(vec2{MouseToWorld.X + (TILE_SIZE * 0.5f), MouseToWorld.Y});
-                static_sprite_data HotbarSprite = GetSprite(State, HotbarItem->Sprite);
+                static_sprite_data HotbarSprite = GetSprite(State, GetItemData(State, HotbarItem->ItemID)->Sprite);
                 
-                mat4 XForm = mat4Identity(1.0f);
-                XForm = mat4Multiply(XForm, mat4Translate(vec3{MousePosition.X, MousePosition.Y  + (TILE_SIZE * 0.5f), 0}));
-                XForm = mat4Multiply(XForm, mat4MakeScale(v2Expand(v2Cast(HotbarSprite.SpriteSize), 1)));
+                affine2d XForm = affine2dMakeTRS(vec2{MousePosition.X, MousePosition.Y  + (TILE_SIZE * 0.5f)}, 0.0f, v2Cast(HotbarSprite.SpriteSize));
                 DrawSpriteXForm(RenderData, XForm, HotbarSprite, 0, vec4{0.2, 0.2, 0.2, 0.3f});
                 
                 if(IsGameKeyPressed(INTERACT, &State->GameInput))
                 {
                     bool Overlap = {};
-                    for(uint32 EntityCounter = 0;
-                        EntityCounter <= State->World.EntityCounter;
-                        EntityCounter++)
+                    for(uint32 EntityIndex = 0;
+                        EntityIndex < State->World.EntityHighWater;
+                        EntityIndex++)
                     {
-                        entity *TestBuildingBounds = &State->World.Entities[EntityCounter];
+                        entity *TestBuildingBounds = GetEntity(State, EntityIndex);
                         Overlap = IsRangeWithinBounds(MouseToWorld, TestBuildingBounds->BoxCollider);
                         if(Overlap)
                         {
@@ -1764,10 +2192,10 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             if(!State->ActiveCraftingStation && State->GameUIState != UI_State_Crafting)
             {
                 for(uint32 EntityIndex = 0;
-                    EntityIndex <= State->World.EntityCounter;
+                    EntityIndex < State->World.EntityHighWater;
                     EntityIndex++)
                 {
-                    entity *Temp = &State->World.Entities[EntityIndex];
+                    entity *Temp = GetEntity(State, EntityIndex);
                     if(Temp->Flags & IS_PLACED)
                     {
                         real32 Distance = v2Distance(Player->Position, Temp->Position);
@@ -1805,14 +2233,10 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             int IconCount = 0;
             int RowCount = 0;
             
-            mat4 XForm = mat4Identity(1.0f);
-            XForm = mat4Translation(XForm, v2Expand(BoxPosition, 0));
-            XForm = mat4Scale(XForm, vec3{BoxWidth, BoxHeight, 1});
+            affine2d XForm = affine2dMakeTRS(BoxPosition, 0.0f, vec2{BoxWidth, BoxHeight});
             CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, SPRITE_Nil), BoxColor);
             
-            XForm = mat4Identity(1.0f);
-            XForm = mat4Translation(XForm, v2Expand(BoxPosition * -1, 0));
-            XForm = mat4Scale(XForm, vec3{BoxWidth, BoxHeight, 1});
+            XForm = affine2dMakeTRS(BoxPosition * -1, 0.0f, vec2{BoxWidth, BoxHeight});
             CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, SPRITE_Nil), BoxColor);
             
             DrawUIText(RenderData, STR("Crafting"), {-55, 40}, 15, UBUNTU_MONO, WHITE);
@@ -1820,23 +2244,22 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                 Element < ITEM_IDCount;
                 Element++)
             {
-                item *Item = &State->GameData.GameItems[Element];
+                const item *Item = GetItemData(State, Element);
                 if((Item && Item->Craftable) && Item && !(Item->Flags & IS_BUILDABLE))
                 {
                     real32 NewXOffset = StartingXOffset + ((IconSize + Padding) * IconCount);
                     real32 NewYOffset = StartingYOffset - ((IconSize + Padding) * RowCount);
                     
-                    XForm = mat4Identity(1.0f);
-                    XForm = mat4Translation(XForm, vec3{NewXOffset, NewYOffset, 0});
+                    XForm = affine2dMakeTRS(vec2{NewXOffset, NewYOffset}, 0.0f, vec2{1.0f, 1.0f});
                     
                     vec2 SpriteSize = {IconSize, IconSize};
                     if(Item == State->ActiveRecipe)
                     {
                         SpriteSize = {14, 14};
                     }
-                    XForm = mat4Scale(XForm, v2Expand(SpriteSize, 1));
+                    XForm = affine2dMultiply(XForm, affine2dMakeTRS(vec2{0.0f, 0.0f}, 0.0f, SpriteSize));
                     CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, Item->Sprite), WHITE);
-                    vec2 Position = XForm.Columns[3].XY;
+                    vec2 Position = XForm.Offset;
                     CloverUIPushLayer(&State->UIContext, 1);
                     ui_element_state Button = CloverUIButton(&State->UIContext, STR("Element"), Position, SpriteSize, GetSprite(State, SPRITE_Outline), WHITE);
                     CloverUIPushLayer(&State->UIContext, 0);
@@ -1862,12 +2285,10 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
             // NOTE(Sleepster): If we have an active recipe, display the recipe
             if(State->ActiveRecipe)
             {
-                item *Item = State->ActiveRecipe;
+                const item *Item = State->ActiveRecipe;
                 CloverUIMakeTextElement(&State->UIContext, Item->ItemName, {50, 40}, 15, TEXT_ALIGNMENT_Center, WHITE);
                 
-                XForm = mat4Identity(1.0f);
-                XForm = mat4Translation(XForm, vec3{45, 30, 0});
-                XForm = mat4Scale(XForm, vec3{IconSize, IconSize, 1});
+                XForm = affine2dMakeTRS(vec2{45, 30}, 0.0f, vec2{IconSize, IconSize});
                 CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, Item->Sprite), WHITE);
                 
                 int InventoryCount[MAX_CRAFTING_ELEMENTS] = {};
@@ -1875,12 +2296,12 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                     InventorySlotIndex < TOTAL_INVENTORY_SIZE;
                     InventorySlotIndex++)
                 {
-                    item *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
+                    inventory_slot *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
                     for(int32 FormulaIndex = 0;
                         FormulaIndex < State->ActiveRecipe->UniqueMaterialCount;
                         ++FormulaIndex)
                     {
-                        crafting_material *FormulaItem = &State->ActiveRecipe->CraftingFormula[FormulaIndex];
+                        const crafting_material *FormulaItem = &State->ActiveRecipe->CraftingFormula[FormulaIndex];
                         if(InventoryItem->ItemID == FormulaItem->CraftingMaterial)
                         {
                             InventoryCount[FormulaIndex] = InventoryItem->CurrentStack;
@@ -1893,17 +2314,13 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                     MaterialIndex < Item->UniqueMaterialCount;
                     MaterialIndex++)
                 {
-                    crafting_material *Material = &Item->CraftingFormula[MaterialIndex];
+                    const crafting_material *Material = &Item->CraftingFormula[MaterialIndex];
                     real32 NewYOffset = InitialYOffset - ((14 + Padding) * MaterialIndex);
                     
-                    XForm = mat4Identity(1.0f);
-                    XForm = mat4Translation(XForm, vec3{45, NewYOffset, 0});
-                    XForm = mat4Scale(XForm, vec3{30, 12, 1});
+                    XForm = affine2dMakeTRS(vec2{45, NewYOffset}, 0.0f, vec2{30, 12});
                     CloverUISpriteElement(&State->UIContext, {0, 0}, {0, 0}, XForm, GetSprite(State, SPRITE_Nil), {0.4, 0.4, 0.4, 0.3});
                     
-                    XForm = mat4Identity(1.0f);
-                    XForm = mat4Translation(XForm, vec3{40, NewYOffset, 0});
-                    XForm = mat4Scale(XForm, vec3{8, 8, 1});
+                    XForm = affine2dMakeTRS(vec2{40, NewYOffset}, 0.0f, vec2{8, 8});
                     
                     static_sprite_data Sprite = GetSprite(State, GetSpriteFromPair(State, Material->CraftingMaterial));
                     
@@ -1934,7 +2351,7 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                             Index++)
                         {
                             entity *CraftedItem = CreateEntity(State);
-                            SetupDroppedEntity(RenderData, State, State->ActiveRecipe, CraftedItem);
+                            SetupDroppedEntity(RenderData, State, State->ActiveRecipe->ItemID, 0, CraftedItem);
                             CraftedItem->Position = State->ActiveCraftingStation->Position;
                             CraftedItem->Target = State->ActiveCraftingStation->Position;
                         }
@@ -1943,12 +2360,12 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
                             InventorySlotIndex < TOTAL_INVENTORY_SIZE;
                             InventorySlotIndex++)
                         {
-                            item *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
+                            inventory_slot *InventoryItem = &Player->Inventory.Items[InventorySlotIndex];
                             for(int32 FormulaIndex = 0;
                                 FormulaIndex < State->ActiveRecipe->UniqueMaterialCount;
                                 ++FormulaIndex)
                             {
-                                crafting_material *FormulaItem = &State->ActiveRecipe->CraftingFormula[FormulaIndex];
+                                const crafting_material *FormulaItem = &State->ActiveRecipe->CraftingFormula[FormulaIndex];
                                 if(InventoryItem->ItemID == FormulaItem->CraftingMaterial)
                                 {
                                     InventoryItem->CurrentStack -= FormulaItem->RequiredCount;
@@ -1992,14 +2409,14 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
     
     // NOTE(Sleepster): Sorting, off for now. Breaks too much 
     {
-        //qsort(State->World.Entities, State->World.EntityCounter, sizeof(struct entity), CompareEntityYAxis); 
+        //qsort(State->World.EntityPages[0], State->World.EntityHighWater, sizeof(struct entity), CompareEntityYAxis); 
     }
     
     for(uint32 EntityIndex = 0;
-        EntityIndex <= State->World.EntityCounter;
+        EntityIndex < State->World.EntityHighWater;
         ++EntityIndex)
     {
-        entity *Temp = &State->World.Entities[EntityIndex];
+        entity *Temp = GetEntity(State, EntityIndex);
         if((Temp->Flags & IS_VALID))
         {
             real32 Distance = fabsf(v2Distance(Temp->Position, MouseToWorld));
@@ -2015,61 +2432,8 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
         }
     }
 
-    vec2 SelectionBoxDrawSize = {16, 16};
-    // NOTE(Sleepster): DRAW ENTITIES
-    for(uint32 EntityIndex = 0;
-        EntityIndex <= State->World.EntityCounter;
-        ++EntityIndex)
-    {
-        entity *Temp = &State->World.Entities[EntityIndex];
-        SelectionBoxDrawSize.X = SinBreatheNormalized(Time.CurrentTimeInSeconds, 0.5f, 13.0f, 15.0f);
-        SelectionBoxDrawSize.Y = SinBreatheNormalized(Time.CurrentTimeInSeconds, 0.5f, 13.0f, 15.0f);
-        
-        if(Temp->Flags & IS_VALID)
-        {
-            switch(Temp->Archetype)
-            {
-                case ARCH_Player:
-                {
-                    Player = Temp;
-                    HandleInput(State, Temp, Time);
-                    RenderData->GameCamera.Target = Temp->Position;
-                    
-                    v2Approach(&RenderData->GameCamera.Position, RenderData->GameCamera.Target, 5.0f, Time.Delta);
-                    DrawEntity(RenderData, State, Temp, Temp->Position, WHITE);
-                }break;
-                default:
-                {
-                    if(Temp->Flags & IS_ITEM)
-                    {
-                        v2Approach(&Temp->Position, Temp->Target, 5.0f, Time.Delta);
-                        Temp->Position.Y += 0.01f * SinBreathe(Time.CurrentTimeInSeconds, 1.25f);
-                        if(v2Distance(Temp->Target, Temp->Position) <= PickupEpsilon)
-                        {
-                            Temp->Flags += CAN_BE_PICKED_UP;
-                        }
-                    }
-
-                    if(State->World.WorldFrame.SelectedEntity == Temp && !(Temp->Flags & IS_ITEM))
-                    {
-                        State->World.WorldFrame.SelectedEntity = Temp;
-                        static_sprite_data SelectionBoxSprite = GetSprite(State, SPRITE_SelectionBox);
-                        static_sprite_data EntitySprite = GetSprite(State, Temp->Sprite);
-                        
-                        DrawSprite(RenderData, 
-                                   SelectionBoxSprite, 
-                                   Temp->Position 
-                                   - vec2{0, real32(EntitySprite.SpriteSize.Y * 0.25f)},
-                                   SelectionBoxDrawSize, 
-                                   WHITE, 
-                                   0, 
-                                   0);
-                    }
-                    DrawEntity(RenderData, State, Temp, Temp->Position, WHITE);
-                }break;
-            }
-        }
-    }
+    // NOTE(Sleepster): UPDATE AND DRAW ENTITIES
+    RunEntitySystems(Memory, RenderData, State, Time);
 
     // NOTE(Sleepster): Draw the Tiles
     ivec2  PlayerOffset = WorldToTilePos(Player->Position);
@@ -2100,4 +2464,5 @@ GAME_UPDATE_AND_DRAW(GameUpdateAndDraw)
 extern
 GAME_FIXED_UPDATE(GameFixedUpdate)
 {
+    TimerWheelTick(State, &State->Timers);
 }
@@ -15,6 +15,7 @@
 #include "Clover_Audio.h"
 #include "Clover_Renderer.h"
 #include "Clover_UI.h"
+#include "Clover_Timers.h"
 
 struct sound_instance
 {
@@ -148,6 +149,7 @@ struct crafting_material
     int32   RequiredCount;
 };
 
+// NOTE(Sleepster): Static item definition, these live in GameData.GameItems and are never copied around. 
 struct item
 {
     uint32      Archetype;
@@ -156,9 +158,6 @@ struct item
     item_id     ItemID;
     
     int32       MaxStackCount;
-    int32       CurrentStack;
-    
-    int32       OccupiedInventorySlot;
     
     string      ItemName;
     string      ItemDesc;
@@ -170,16 +169,24 @@ struct item
     bool Craftable;
 };
 
+// NOTE(Sleepster): Per-instance inventory state only, anything static is read from the item definition by ItemID 
+struct inventory_slot
+{
+    uint16 ItemID;
+    int16  CurrentStack;
+    uint32 Flags;
+};
+
 struct entity_item_inventory
 {
-    item  Items[TOTAL_INVENTORY_SIZE];
+    inventory_slot Items[TOTAL_INVENTORY_SIZE];
     uint32 CurrentItemCount;
     uint32 LowestAvaliableSlot;
     
-    item *SelectedInventoryItem;
-    item *SwapItem;
+    inventory_slot *SelectedInventoryItem;
+    inventory_slot *SwapItem;
     
-    item *SelectedHotbarItem;
+    inventory_slot *SelectedHotbarItem;
     
     ui_element *InventorySlotButtons[TOTAL_INVENTORY_SIZE];
     uint32 CurrentInventorySlot;
@@ -220,6 +227,13 @@ struct entity
     int32 UniqueDropCount;
 };
 
+struct game_state;
+
+// NOTE(Sleepster): Systems are run once per archetype over a contiguous span of that archetype's entities.
+//                  Visible runs parallel to Entities, anything that's false is outside the camera and shouldn't be drawn
+#define ENTITY_SYSTEM(name) void name(gl_render_data *RenderData, game_state *State, entity **Entities, bool8 *Visible, uint32 EntityCount, time Time)
+typedef ENTITY_SYSTEM(entity_system);
+
 struct game_state
 {
     KeyCodeID KeyCodeLookup[KEY_COUNT];
@@ -228,28 +242,40 @@ struct game_state
     clover_ui_context UIContext;
     game_ui_state     GameUIState;
     
+    timer_wheel       Timers;
+    
     bool DisplayPlayerHotbar;
     bool DisplayPlayerInventory;
     bool DisplayCraftingMenu;
     bool DisplayBuildMenu;
     bool DrawDebug;
     
-    entity *ActiveCraftingStation;
-    item   *ActiveRecipe;
+    entity     *ActiveCraftingStation;
+    const item *ActiveRecipe;
     
-    item   *ActiveBlueprint;
+    const item *ActiveBlueprint;
     
     // NOTE(Sleepster): World Data
     struct
     {
-        entity Entities[MAX_ENTITIES];  
-        item   Items[1000];
-        uint32 EntityCounter;
+        // NOTE(Sleepster): Use GetEntity(), pages are never moved so entity pointers stay valid 
+        entity       *EntityPages[MAX_ENTITY_PAGES];
+        memory_arena *EntityArena;
+        uint32        EntityPageCount;
+        uint32        MaxEntityCount;
+        
+        // NOTE(Sleepster): One past the highest index ever handed out, and where CreateEntity starts looking
+        uint32 EntityHighWater;
+        uint32 FirstFreeEntity;
         
         struct 
         {
             entity *SelectedEntity;
         }WorldFrame;
+        
+        // NOTE(Sleepster): DrawWorldEntitySpan's batch. Lives here instead of on the stack since a helper can still be
+        //                  sitting in the work queue after the span that added it returned
+        work_batch EntityDrawBatch;
     }World;
     
     // NOTE(Sleepster): Audio Stuffs
@@ -268,29 +294,41 @@ struct game_state
     struct 
     { 
         static_sprite_data          Sprites[SPRITE_Count];
+        uint32                      SpriteAtlasGeneration;
         item                        GameItems[ITEM_IDCount];
         pair <item_id, sprite_type> ItemSprites[ITEM_IDCount];
 
         void (*EntitySetupFunctions[ARCH_ID_MAX])(game_state*, entity*);
+        entity_system *EntityUpdateSystems[ARCH_ID_MAX];
+        
+        // NOTE(Sleepster): Last frame's __rdtsc() cost for each archetype's system, shown in the debug window 
+        uint64 EntitySystemCycles[ARCH_ID_MAX];
+        uint32 EntitySystemCounts[ARCH_ID_MAX];
+        uint32 EntitySystemVisible[ARCH_ID_MAX];
     }GameData;
 };
 
 // NOTE(Sleepster): Utilities
+internal inline uint64
+GetEntityStorageSize(uint32 MaxEntityCount)
+{
+    uint64 PageCount = (MaxEntityCount + ENTITIES_PER_PAGE - 1) / ENTITIES_PER_PAGE;
+    return(PageCount * ENTITIES_PER_PAGE * (sizeof(entity) + sizeof(uint32)));
+}
+
 internal vec2
 TransformMouseCoords(mat4 ViewMatrix, mat4 ProjectionMatrix, ivec2 MousePos, ivec4 WindowSizeData)
 {
     vec2 TransformedMousePos  = {};
     
     vec2 Ndc = {(MousePos.X / (WindowSizeData.Width * 0.5f)) - 1.0f, 1.0f - (MousePos.Y / (WindowSizeData.Height * 0.5f))};
-    vec4 NDCPosition = v2Expand(Ndc, 0.0f, 1.0f);
-    
-    mat4 InverseProjection = mat4Inverse(ProjectionMatrix);
-    mat4 InverseViewMatrix = mat4Inverse(ViewMatrix);
     
-    NDCPosition = mat4Transform(InverseProjection, NDCPosition);
-    NDCPosition = mat4Transform(InverseViewMatrix, NDCPosition);
+    // NOTE(Sleepster): Both cameras are orthographic with 2D views, so the XY part of each is affine
+    //                  and a 2x3 inverse does the job of the two full mat4 inverses
+    affine2d InverseProjection = affine2dInverse(affine2dFromMat4(ProjectionMatrix));
+    affine2d InverseViewMatrix = affine2dInverse(affine2dFromMat4(ViewMatrix));
     
-    TransformedMousePos = {NDCPosition.X, NDCPosition.Y};
+    TransformedMousePos = affine2dTransformPoint(InverseViewMatrix, affine2dTransformPoint(InverseProjection, Ndc));
     return(TransformedMousePos);
 }
 
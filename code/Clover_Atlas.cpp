@@ -0,0 +1,511 @@
+/* ========================================================================
+   $File: Clover_Atlas.cpp $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "Intrinsics.h"
+
+// CLOVER HEADERS
+#include "Clover_Globals.h"
+#include "Clover_Atlas.h"
+#include "Clover_Renderer.h"
+
+internal inline void
+SkylineReset(skyline_packer *Packer)
+{
+    Packer->Nodes[0]  = {0, 0, Packer->PageWidth};
+    Packer->NodeCount = 1;
+}
+
+internal inline void
+SkylineRemoveNode(skyline_packer *Packer, uint32 NodeIndex)
+{
+    memmove(&Packer->Nodes[NodeIndex], &Packer->Nodes[NodeIndex + 1], sizeof(skyline_node) * (Packer->NodeCount - NodeIndex - 1));
+    --Packer->NodeCount;
+}
+
+// NOTE(Sleepster): Returns the Y a Width wide rect would rest at if its left edge sits on NodeIndex, -1 if it doesn't fit
+internal int32
+SkylineFitAt(skyline_packer *Packer, uint32 NodeIndex, int32 Width, int32 Height)
+{
+    if(Packer->Nodes[NodeIndex].X + Width > Packer->PageWidth) return(-1);
+
+    int32 Y = 0;
+    int32 WidthLeft = Width;
+    for(uint32 Index = NodeIndex;
+        WidthLeft > 0;
+        ++Index)
+    {
+        Y = MAX(Y, Packer->Nodes[Index].Y);
+        if(Y + Height > Packer->PageHeight) return(-1);
+
+        WidthLeft -= Packer->Nodes[Index].Width;
+    }
+    return(Y);
+}
+
+// NOTE(Sleepster): Bottom left rule, the spot that leaves the lowest top edge wins and ties go to the narrowest segment
+internal bool8
+SkylinePack(skyline_packer *Packer, int32 Width, int32 Height, int32 *OutX, int32 *OutY)
+{
+    int32 BestTop   = INT32_MAX;
+    int32 BestWidth = INT32_MAX;
+    int32 BestIndex = -1;
+    int32 BestY     = 0;
+    for(uint32 NodeIndex = 0;
+        NodeIndex < Packer->NodeCount;
+        ++NodeIndex)
+    {
+        int32 Y = SkylineFitAt(Packer, NodeIndex, Width, Height);
+        if(Y < 0) continue;
+
+        int32 Top = Y + Height;
+        if(Top < BestTop || (Top == BestTop && Packer->Nodes[NodeIndex].Width < BestWidth))
+        {
+            BestTop   = Top;
+            BestWidth = Packer->Nodes[NodeIndex].Width;
+            BestIndex = int32(NodeIndex);
+            BestY     = Y;
+        }
+    }
+    if(BestIndex < 0) return(false);
+
+    // NOTE(Sleepster): The new segment goes in at BestIndex, whatever it covers to the right gets trimmed or dropped
+    skyline_node *Nodes = Packer->Nodes;
+    int32 X = Nodes[BestIndex].X;
+    memmove(&Nodes[BestIndex + 1], &Nodes[BestIndex], sizeof(skyline_node) * (Packer->NodeCount - BestIndex));
+    Nodes[BestIndex] = {X, BestY + Height, Width};
+    ++Packer->NodeCount;
+
+    uint32 Index = BestIndex + 1;
+    while(Index < Packer->NodeCount)
+    {
+        int32 PrevRight = Nodes[Index - 1].X + Nodes[Index - 1].Width;
+        if(Nodes[Index].X >= PrevRight) break;
+
+        int32 Shrink = PrevRight - Nodes[Index].X;
+        Nodes[Index].X     += Shrink;
+        Nodes[Index].Width -= Shrink;
+        if(Nodes[Index].Width > 0) break;
+
+        SkylineRemoveNode(Packer, Index);
+    }
+
+    for(Index = 0;
+        Index + 1 < Packer->NodeCount;)
+    {
+        if(Nodes[Index].Y == Nodes[Index + 1].Y)
+        {
+            Nodes[Index].Width += Nodes[Index + 1].Width;
+            SkylineRemoveNode(Packer, Index + 1);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    *OutX = X;
+    *OutY = BestY;
+    return(true);
+}
+
+// NOTE(Sleepster): Editing a png in place doesn't touch the directory's own write time, so hot reload watches the newest
+//                  png as well. The directory's time still counts for sprites being added or removed.
+internal FILETIME
+CloverGetSpriteDirectoryWriteTime(string Directory)
+{
+    FILETIME Result = Win32GetLastWriteTime(Directory);
+
+    char SearchPath[MAX_PATH] = {};
+    snprintf(SearchPath, MAX_PATH, "%s/*.png", CSTR(Directory));
+
+    WIN32_FIND_DATAA FindData;
+    HANDLE FindHandle = FindFirstFileA(SearchPath, &FindData);
+    if(FindHandle != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if(FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+            if(CompareFileTime(&FindData.ftLastWriteTime, &Result) > 0)
+            {
+                Result = FindData.ftLastWriteTime;
+            }
+        }while(FindNextFileA(FindHandle, &FindData));
+        FindClose(FindHandle);
+    }
+
+    return(Result);
+}
+
+internal uint32
+CloverGatherSpriteSources(memory_arena *Scratch, string Directory, sprite_atlas_source *Sources, uint64 *ContentHash)
+{
+    uint32 SourceCount = 0;
+    uint64 Hash = 0;
+
+    char SearchPath[MAX_PATH] = {};
+    snprintf(SearchPath, MAX_PATH, "%s/*.png", CSTR(Directory));
+
+    WIN32_FIND_DATAA FindData;
+    HANDLE FindHandle = FindFirstFileA(SearchPath, &FindData);
+    if(FindHandle != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if(FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+            Assert(SourceCount < MAX_ATLAS_SPRITES);
+
+            sprite_atlas_source *Source = &Sources[SourceCount++];
+            *Source = {};
+
+            uint32 NameLength = uint32(strlen(FindData.cFileName)) - 4;
+            NameLength = MIN(NameLength, SPRITE_NAME_LENGTH - 1);
+            memcpy(Source->Name, FindData.cFileName, NameLength);
+
+            char FilePath[MAX_PATH] = {};
+            snprintf(FilePath, MAX_PATH, "%s/%s", CSTR(Directory), FindData.cFileName);
+            string File = ReadEntireFileMA(Scratch, STR(FilePath), &Source->FileSize);
+            Source->FileData = File.Data;
+
+            // NOTE(Sleepster): Summing the per file hashes keeps the key independent of the directory's enumeration order
+            uint64 FileHash = CloverHashBytes(0xCBF29CE484222325ull, Source->Name, SPRITE_NAME_LENGTH);
+            FileHash = CloverHashBytes(FileHash, Source->FileData, Source->FileSize);
+            Hash += FileHash * 0x9E3779B97F4A7C15ull;
+        }while(FindNextFileA(FindHandle, &FindData));
+        FindClose(FindHandle);
+    }
+
+    uint32 Layout[3] = {SPRITE_ATLAS_CACHE_VERSION, SPRITE_ATLAS_PAGE_SIZE, uint32(SPRITE_ATLAS_PADDING)};
+    *ContentHash = CloverHashBytes(Hash, Layout, sizeof(Layout));
+    return(SourceCount);
+}
+
+internal bool8
+CloverReadSpriteAtlasCache(memory_arena *Scratch, string CachePath, uint64 ContentHash, uint32 SourceCount,
+                           sprite_atlas_entry *Entries, uint8 **Pages, uint32 *PageCount)
+{
+    bool8 Result = false;
+
+    FILE *File = fopen(CSTR(CachePath), "rb");
+    if(File)
+    {
+        sprite_atlas_cache_header Header = {};
+        fread(&Header, sizeof(Header), 1, File);
+        if(Header.Magic       == SPRITE_ATLAS_CACHE_MAGIC   &&
+           Header.Version     == SPRITE_ATLAS_CACHE_VERSION &&
+           Header.ContentHash == ContentHash                &&
+           Header.PageSize    == SPRITE_ATLAS_PAGE_SIZE     &&
+           Header.SpriteCount == SourceCount                &&
+           Header.PageCount   <= MAX_SPRITE_ATLAS_PAGES)
+        {
+            uint64 PageBytes = uint64(SPRITE_ATLAS_PAGE_SIZE) * SPRITE_ATLAS_PAGE_SIZE * 4;
+            *Pages = (uint8 *)ArenaAlloc(Scratch, PageBytes * Header.PageCount);
+
+            Result = fread(Entries, sizeof(sprite_atlas_entry), Header.SpriteCount, File) == Header.SpriteCount &&
+                     fread(*Pages, PageBytes, Header.PageCount, File) == Header.PageCount;
+            *PageCount = Header.PageCount;
+
+            for(uint32 EntryIndex = 0;
+                Result && EntryIndex < Header.SpriteCount;
+                ++EntryIndex)
+            {
+                Result = (Entries[EntryIndex].Width == 0) || (Entries[EntryIndex].Page < Header.PageCount);
+            }
+        }
+        fclose(File);
+    }
+
+    return(Result);
+}
+
+internal void
+CloverWriteSpriteAtlasCache(string CachePath, uint64 ContentHash, sprite_atlas_entry *Entries, uint32 EntryCount, uint8 *Pages, uint32 PageCount)
+{
+    char CacheDirectory[MAX_PATH] = {};
+    memcpy(CacheDirectory, CachePath.Data, MIN(CachePath.Length, uint64(MAX_PATH - 1)));
+    char *LastSlash = strrchr(CacheDirectory, '/');
+    if(LastSlash)
+    {
+        *LastSlash = 0;
+        CreateDirectoryA(CacheDirectory, 0);
+    }
+
+    FILE *File = fopen(CSTR(CachePath), "wb");
+    if(File)
+    {
+        sprite_atlas_cache_header Header = {};
+        Header.Magic       = SPRITE_ATLAS_CACHE_MAGIC;
+        Header.Version     = SPRITE_ATLAS_CACHE_VERSION;
+        Header.ContentHash = ContentHash;
+        Header.PageSize    = SPRITE_ATLAS_PAGE_SIZE;
+        Header.PageCount   = PageCount;
+        Header.SpriteCount = EntryCount;
+
+        uint64 PageBytes = uint64(SPRITE_ATLAS_PAGE_SIZE) * SPRITE_ATLAS_PAGE_SIZE * 4;
+        fwrite(&Header, sizeof(Header), 1, File);
+        fwrite(Entries, sizeof(sprite_atlas_entry), EntryCount, File);
+        fwrite(Pages, PageBytes, PageCount, File);
+        fclose(File);
+    }
+    else
+    {
+        Trace("Failed to write the sprite atlas cache, it'll be repacked next launch\n");
+    }
+}
+
+// NOTE(Sleepster): Sprites go in tallest first, then widest, which keeps the skyline flat. Only the newest page is
+//                  open, once a sprite doesn't fit the next page starts. Only places the sprites, returns the page count.
+internal uint32
+CloverPackSpriteAtlas(memory_arena *Scratch, sprite_atlas_source *Sources, uint32 SourceCount, sprite_atlas_entry *Entries)
+{
+    uint64 *SortKeys    = (uint64 *)ArenaAlloc(Scratch, sizeof(uint64) * (SourceCount + 1));
+    uint64 *SortScratch = (uint64 *)ArenaAlloc(Scratch, sizeof(uint64) * (SourceCount + 1));
+    for(uint32 SourceIndex = 0;
+        SourceIndex < SourceCount;
+        ++SourceIndex)
+    {
+        sprite_atlas_source *Source = &Sources[SourceIndex];
+        int32 Channels;
+        stbi_info_from_memory(Source->FileData, int32(Source->FileSize), &Source->Width, &Source->Height, &Channels);
+
+        uint64 Key = SourceIndex;
+        if(strcmp(Source->Name, SPRITE_ATLAS_BLANK_NAME) != 0)
+        {
+            Key |= (uint64(0xFFFF - MIN(Source->Height, 0xFFFF)) << 48) | (uint64(0xFFFF - MIN(Source->Width, 0xFFFF)) << 32);
+        }
+        SortKeys[SourceIndex] = Key;
+    }
+    CloverRadixSortKeys(SortKeys, SortScratch, SourceCount);
+
+    skyline_packer Packer = {};
+    Packer.PageWidth  = SPRITE_ATLAS_PAGE_SIZE;
+    Packer.PageHeight = SPRITE_ATLAS_PAGE_SIZE;
+    Packer.Nodes      = (skyline_node *)ArenaAlloc(Scratch, sizeof(skyline_node) * (SPRITE_ATLAS_PAGE_SIZE + 2));
+    SkylineReset(&Packer);
+
+    uint32 PageCount  = 1;
+    bool8  OutOfPages = false;
+    for(uint32 KeyIndex = 0;
+        KeyIndex < SourceCount;
+        ++KeyIndex)
+    {
+        uint32 SourceIndex = uint32(SortKeys[KeyIndex] & 0xFFFFFFFF);
+        sprite_atlas_source *Source = &Sources[SourceIndex];
+        sprite_atlas_entry  *Entry  = &Entries[SourceIndex];
+
+        *Entry = {};
+        memcpy(Entry->Name, Source->Name, SPRITE_NAME_LENGTH);
+
+        int32 X = 0;
+        int32 Y = 0;
+        int32 PaddedWidth  = Source->Width  + SPRITE_ATLAS_PADDING;
+        int32 PaddedHeight = Source->Height + SPRITE_ATLAS_PADDING;
+        if(PaddedWidth > SPRITE_ATLAS_PAGE_SIZE || PaddedHeight > SPRITE_ATLAS_PAGE_SIZE)
+        {
+            Trace("Sprite is bigger than an atlas page, it'll draw as the blank sprite\n");
+            continue;
+        }
+
+        if(!SkylinePack(&Packer, PaddedWidth, PaddedHeight, &X, &Y))
+        {
+            // NOTE(Sleepster): Once every page is open anything that doesn't fit what's left stays unplaced,
+            //                  smaller sprites further down the sort can still fill the gaps in the last page
+            if(PageCount == MAX_SPRITE_ATLAS_PAGES)
+            {
+                if(!OutOfPages)
+                {
+                    Trace("The sprites need more atlas pages than MAX_SPRITE_ATLAS_PAGES, the rest draw as the blank sprite\n");
+                    OutOfPages = true;
+                }
+                continue;
+            }
+
+            // NOTE(Sleepster): Can't fail, the size was checked against an empty page above
+            SkylineReset(&Packer);
+            ++PageCount;
+            SkylinePack(&Packer, PaddedWidth, PaddedHeight, &X, &Y);
+        }
+
+        Entry->X      = uint16(X);
+        Entry->Y      = uint16(Y);
+        Entry->Width  = uint16(Source->Width);
+        Entry->Height = uint16(Source->Height);
+        Entry->Page   = PageCount - 1;
+    }
+
+    return(PageCount);
+}
+
+// NOTE(Sleepster): Packed rects never overlap, so any number of these can blit into the same pages at once
+internal WORK_QUEUE_CALLBACK(CloverDecodeSpriteBatchWork)
+{
+    sprite_atlas_decode_batch *Batch = (sprite_atlas_decode_batch *)Data;
+    sprite_atlas_build        *Build = Batch->Build;
+    for(uint32 SourceIndex = Batch->FirstSource;
+        SourceIndex < Batch->OnePastLastSource;
+        ++SourceIndex)
+    {
+        sprite_atlas_source *Source = &Build->Sources[SourceIndex];
+        sprite_atlas_entry  *Entry  = &Build->Entries[SourceIndex];
+        if(Entry->Width == 0) continue;
+
+        int32 Width, Height, Channels;
+        uint8 *Pixels = stbi_load_from_memory(Source->FileData, int32(Source->FileSize), &Width, &Height, &Channels, 4);
+        if(Pixels)
+        {
+            uint8 *Page = Build->Pages + (TEXTURE_STAGING_REGION_SIZE * Entry->Page);
+            for(int32 Row = 0;
+                Row < Height;
+                ++Row)
+            {
+                memcpy(Page + ((uint64(Entry->Y + Row) * SPRITE_ATLAS_PAGE_SIZE) + Entry->X) * 4, Pixels + (uint64(Row) * Width * 4), Width * 4);
+            }
+            stbi_image_free(Pixels);
+        }
+    }
+
+    InterlockedDecrement((volatile LONG *)&Build->DecodesRemaining);
+}
+
+// NOTE(Sleepster): Runs on a worker. The decodes get split into batches across the queue, this thread
+//                  works the queue too until its own batches are done instead of sleeping on them.
+internal WORK_QUEUE_CALLBACK(CloverBuildSpriteAtlasWork)
+{
+    sprite_atlas_build *Build = (sprite_atlas_build *)Data;
+    ArenaReset(&Build->Arena);
+
+    Build->Sources = (sprite_atlas_source *)ArenaAlloc(&Build->Arena, sizeof(sprite_atlas_source) * MAX_ATLAS_SPRITES);
+    Build->Entries = (sprite_atlas_entry  *)ArenaAlloc(&Build->Arena, sizeof(sprite_atlas_entry)  * MAX_ATLAS_SPRITES);
+
+    uint64 ContentHash = 0;
+    Build->SpriteCount = CloverGatherSpriteSources(&Build->Arena, Build->Directory, Build->Sources, &ContentHash);
+    Build->PageCount   = 0;
+    if(Build->SpriteCount == 0)
+    {
+        Trace("No sprites found in the sprite directory\n");
+    }
+    else if(!CloverReadSpriteAtlasCache(&Build->Arena, Build->CachePath, ContentHash, Build->SpriteCount, Build->Entries, &Build->Pages, &Build->PageCount))
+    {
+        Build->PageCount = CloverPackSpriteAtlas(&Build->Arena, Build->Sources, Build->SpriteCount, Build->Entries);
+
+        Build->Pages = (uint8 *)ArenaAlloc(&Build->Arena, TEXTURE_STAGING_REGION_SIZE * Build->PageCount);
+        memset(Build->Pages, 0, TEXTURE_STAGING_REGION_SIZE * Build->PageCount);
+
+        uint32 BatchCount = MIN(Build->SpriteCount, Queue->ThreadCount * 4);
+        uint32 BatchSize  = (Build->SpriteCount + BatchCount - 1) / BatchCount;
+        sprite_atlas_decode_batch *Batches = (sprite_atlas_decode_batch *)ArenaAlloc(&Build->Arena, sizeof(sprite_atlas_decode_batch) * BatchCount);
+
+        Build->DecodesRemaining = BatchCount;
+        for(uint32 BatchIndex = 0;
+            BatchIndex < BatchCount;
+            ++BatchIndex)
+        {
+            sprite_atlas_decode_batch *Batch = &Batches[BatchIndex];
+            Batch->Build             = Build;
+            Batch->FirstSource       = MIN(BatchIndex * BatchSize, Build->SpriteCount);
+            Batch->OnePastLastSource = MIN(Batch->FirstSource + BatchSize, Build->SpriteCount);
+            Win32AddWorkEntry(Queue, CloverDecodeSpriteBatchWork, Batch);
+        }
+
+        while(Build->DecodesRemaining > 0)
+        {
+            if(!Win32DoNextWorkEntry(Queue))
+            {
+                _mm_pause();
+            }
+        }
+
+        CloverWriteSpriteAtlasCache(Build->CachePath, ContentHash, Build->Entries, Build->SpriteCount, Build->Pages, Build->PageCount);
+    }
+
+    // NOTE(Sleepster): Staging is write combined, so it only ever gets written front to back and never read
+    memcpy(Build->Staging, Build->Pages, TEXTURE_STAGING_REGION_SIZE * Build->PageCount);
+    InterlockedExchange((volatile LONG *)&Build->State, ATLAS_BUILD_READY);
+}
+
+internal void
+CloverStartSpriteAtlasBuild(gl_render_data *RenderData)
+{
+    sprite_atlas_build *Build = &RenderData->AtlasBuild;
+    if(Build->RebuildRequested && Build->State == ATLAS_BUILD_IDLE && CloverStagingFenceSignaled(&Build->UploadFence))
+    {
+        Build->RebuildRequested = false;
+        Build->State            = ATLAS_BUILD_RUNNING;
+        Win32AddWorkEntry(Build->Queue, CloverBuildSpriteAtlasWork, Build);
+    }
+}
+
+// NOTE(Sleepster): Asks for the sprite atlas to be (re)built from Directory, the build happens on the work queue.
+//                  If one is already running another is started once it lands, so the last request always wins.
+internal void
+CloverLoadSpriteAtlas(memory_arena *Permanent, gl_render_data *RenderData, string Directory, string CachePath)
+{
+    sprite_atlas_build *Build = &RenderData->AtlasBuild;
+    if(!RenderData->AtlasSprites)
+    {
+        RenderData->AtlasSprites = (sprite_atlas_entry *)ArenaAlloc(Permanent, sizeof(sprite_atlas_entry) * MAX_ATLAS_SPRITES);
+
+        Build->Arena   = ArenaCreate(SPRITE_ATLAS_BUILD_STORAGE);
+        Build->Queue   = RenderData->WorkQueue;
+        Build->Staging = RenderData->TextureStaging;
+    }
+
+    Build->Directory        = Directory;
+    Build->CachePath        = CachePath;
+    Build->RebuildRequested = true;
+
+    // NOTE(Sleepster): Stamped now rather than when the build lands so the hot reload check doesn't fire every frame until then
+    RenderData->GameAtlas.Filepath      = Directory;
+    RenderData->GameAtlas.LastWriteTime = CloverGetSpriteDirectoryWriteTime(Directory);
+
+    CloverStartSpriteAtlasBuild(RenderData);
+}
+
+// NOTE(Sleepster): Called once a frame before the game updates. The table and every page swap over on the same frame,
+//                  then SpriteAtlasGeneration bumps so the game knows to pull its sprite data again.
+internal void
+CloverProcessSpriteAtlasBuild(gl_render_data *RenderData)
+{
+    sprite_atlas_build *Build = &RenderData->AtlasBuild;
+    if(Build->State == ATLAS_BUILD_READY)
+    {
+        if(Build->PageCount > 0)
+        {
+            memcpy(RenderData->AtlasSprites, Build->Entries, sizeof(sprite_atlas_entry) * Build->SpriteCount);
+
+            if(RenderData->Software.Enabled)
+            {
+                // NOTE(Sleepster): Staging regions are page sized, the whole run copies over in one go
+                memcpy(RenderData->Software.SpritePages, Build->Staging, TEXTURE_STAGING_REGION_SIZE * Build->PageCount);
+            }
+            else
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, RenderData->TextureStagingBufferID);
+                glBindTexture(GL_TEXTURE_2D_ARRAY, RenderData->SpriteAtlasArrayID);
+                for(uint32 Page = 0;
+                    Page < Build->PageCount;
+                    ++Page)
+                {
+                    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, Page, SPRITE_ATLAS_PAGE_SIZE, SPRITE_ATLAS_PAGE_SIZE, 1,
+                                    GL_RGBA, GL_UNSIGNED_BYTE, (void *)(TEXTURE_STAGING_REGION_SIZE * Page));
+                }
+                glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                Build->UploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+
+            RenderData->SpriteAtlasPageCount = Build->PageCount;
+            RenderData->AtlasSpriteCount     = Build->SpriteCount;
+            ++RenderData->SpriteAtlasGeneration;
+
+            RenderData->GameAtlas.TextureID  = RenderData->SpriteAtlasArrayID;
+            RenderData->GameAtlas.ArrayLayer = 0;
+        }
+        Build->State = ATLAS_BUILD_IDLE;
+    }
+
+    CloverStartSpriteAtlasBuild(RenderData);
+}
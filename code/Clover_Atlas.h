@@ -0,0 +1,118 @@
+#if !defined(CLOVER_ATLAS_H)
+/* ========================================================================
+   $File: Clover_Atlas.h $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define CLOVER_ATLAS_H
+
+#include "Intrinsics.h"
+#include "Clover_Globals.h"
+#include "util/MemoryArena.h"
+
+// NOTE(Sleepster): Every png in the sprite directory is skyline packed into SPRITE_ATLAS_PAGE_SIZE pages at startup.
+//                  The packed pages and the sprite table are baked to a cache file keyed by a hash of the source
+//                  files, so unless the art changed startup just reads the cache straight into the atlas array.
+constexpr uint32 SPRITE_NAME_LENGTH          = 32;
+constexpr uint32 MAX_ATLAS_SPRITES           = 8192;
+constexpr int32  SPRITE_ATLAS_PADDING        = 1;
+constexpr uint32 SPRITE_ATLAS_CACHE_MAGIC    = 0x54414C43; // "CLAT"
+constexpr uint32 SPRITE_ATLAS_CACHE_VERSION  = 1;
+constexpr uint64 SPRITE_ATLAS_BUILD_STORAGE  = Megabytes(128);
+
+#define SPRITE_DIRECTORY        STR("../data/res/sprites")
+#define SPRITE_ATLAS_CACHE_PATH STR("../data/cache/SpriteAtlas.cache")
+
+// NOTE(Sleepster): The blank sprite is always packed first so it lands at (0, 0) of page 0,
+//                  untextured quads and rects sample from there
+#define SPRITE_ATLAS_BLANK_NAME "Nil"
+
+struct sprite_atlas_entry
+{
+    char   Name[SPRITE_NAME_LENGTH];
+    uint16 X;
+    uint16 Y;
+    uint16 Width;
+    uint16 Height;
+    uint32 Page;
+};
+
+struct sprite_atlas_cache_header
+{
+    uint32 Magic;
+    uint32 Version;
+    uint64 ContentHash;
+    uint32 PageSize;
+    uint32 PageCount;
+    uint32 SpriteCount;
+    uint32 Padding0;
+};
+
+struct sprite_atlas_source
+{
+    char   Name[SPRITE_NAME_LENGTH];
+    uint8 *FileData;
+    uint32 FileSize;
+    int32  Width;
+    int32  Height;
+};
+
+// NOTE(Sleepster): Skyline is the top edge of everything placed so far as a list of horizontal segments,
+//                  left to right, always covering the full page width
+struct skyline_node
+{
+    int32 X;
+    int32 Y;
+    int32 Width;
+};
+
+struct skyline_packer
+{
+    int32         PageWidth;
+    int32         PageHeight;
+
+    skyline_node *Nodes;
+    uint32        NodeCount;
+};
+
+enum sprite_atlas_build_state
+{
+    ATLAS_BUILD_IDLE,
+    ATLAS_BUILD_RUNNING,
+    ATLAS_BUILD_READY,
+};
+
+// NOTE(Sleepster): The whole build runs on the work queue, reading the cache or decoding and packing the pngs into
+//                  its own arena. The finished pages get copied into the staging buffer and the main thread picks them up
+//                  once State is ATLAS_BUILD_READY, until then the old atlas (or the placeholder page) keeps drawing.
+struct sprite_atlas_build
+{
+    volatile uint32      State;
+    volatile uint32      DecodesRemaining;
+    bool8                RebuildRequested;
+
+    struct work_queue   *Queue;
+    memory_arena         Arena;
+    uint8               *Staging;
+    GLsync               UploadFence;
+
+    string               Directory;
+    string               CachePath;
+
+    sprite_atlas_source *Sources;
+    sprite_atlas_entry  *Entries;
+    uint8               *Pages;
+    uint32               SpriteCount;
+    uint32               PageCount;
+};
+
+struct sprite_atlas_decode_batch
+{
+    sprite_atlas_build *Build;
+    uint32              FirstSource;
+    uint32              OnePastLastSource;
+};
+
+#endif // CLOVER_ATLAS_H
@@ -0,0 +1,276 @@
+/* ========================================================================
+   $File: Clover_Capture.cpp $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "Intrinsics.h"
+
+// CLOVER HEADERS
+#include "Clover_Globals.h"
+#include "Clover_Capture.h"
+
+// NOTE(Sleepster): Inverse of PackSpriteInstance, plus the pass and layer out of the sort key
+internal void
+CloverUnpackCaptureQuad(sprite_instance *Instance, uint64 SortKey, frame_capture_quad *Out)
+{
+    frame_capture_quad Result = {};
+    Result.Position   = Instance->Position;
+    Result.Size       = {HalfToFloat(Instance->Size[0]), HalfToFloat(Instance->Size[1])};
+    Result.Rotation   = HalfToFloat(Instance->Rotation);
+    Result.Color      =
+    {
+        real32((Instance->DrawColor >>  0) & 0xFF) / 255.0f,
+        real32((Instance->DrawColor >>  8) & 0xFF) / 255.0f,
+        real32((Instance->DrawColor >> 16) & 0xFF) / 255.0f,
+        real32((Instance->DrawColor >> 24) & 0xFF) / 255.0f,
+    };
+    Result.AtlasMin   = {real32(Instance->AtlasRect[0]), real32(Instance->AtlasRect[1])};
+    Result.AtlasMax   = {real32(Instance->AtlasRect[0] + Instance->AtlasRect[2]), real32(Instance->AtlasRect[1] + Instance->AtlasRect[3])};
+    Result.AnimParams =
+    {
+        (real32(Instance->AnimParams[0]) / 255.0f) * SPRITE_ANIM_PHASE_RANGE,
+        (real32(Instance->AnimParams[1]) / 255.0f) * SPRITE_ANIM_AMPLITUDE_RANGE,
+        (real32(Instance->AnimParams[2]) / 255.0f) * SPRITE_ANIM_FREQUENCY_RANGE,
+    };
+    Result.TextureIndex = Instance->TextureIndex;
+    Result.Flags        = Instance->Flags;
+    Result.Layer        = uint8((SortKey >> SORT_KEY_LAYER_SHIFT) & 0xFF);
+    Result.Pass         = uint8(SortKey >> SORT_KEY_PASS_SHIFT);
+
+    *Out = Result;
+}
+
+// NOTE(Sleepster): Has to run before CloverRender, it resets DrawFrame once it's done with it
+internal bool8
+CloverCaptureFrame(gl_render_data *RenderData, const char *Filepath)
+{
+    CreateDirectoryA("../data/cache", 0);
+    CreateDirectoryA(FRAME_CAPTURE_DIRECTORY, 0);
+
+    FILE *File = fopen(Filepath, "wb");
+    if(!File)
+    {
+        Trace("Failed to open the frame capture for writing\n");
+        return(false);
+    }
+
+    frame_capture_header Header = {};
+    Header.Magic           = FRAME_CAPTURE_MAGIC;
+    Header.Version         = FRAME_CAPTURE_VERSION;
+    Header.QuadCount       = RenderData->DrawFrame.QueuedQuadCount;
+    Header.PointLightCount = uint32(RenderData->DrawFrame.PointLightCount);
+    Header.SpotLightCount  = uint32(RenderData->DrawFrame.SpotLightCount);
+    Header.ViewportWidth   = SizeData.Width;
+    Header.ViewportHeight  = SizeData.Height;
+    Header.AnimationTime   = RenderData->AnimationTime;
+    Header.Brightness      = RenderBrightness;
+    Header.ClearColor      = RenderData->ClearColor;
+    Header.GameProjection  = RenderData->GameCamera.ProjectionMatrix;
+    Header.GameView        = RenderData->GameCamera.ViewMatrix;
+    Header.UIProjection    = RenderData->GameUICamera.ProjectionMatrix;
+    Header.UIView          = RenderData->GameUICamera.ViewMatrix;
+    fwrite(&Header, sizeof(Header), 1, File);
+
+    uint32 QuadIndex = 0;
+    for(render_chunk *Chunk = RenderData->DrawFrame.FirstChunk;
+        Chunk;
+        Chunk = Chunk->Next)
+    {
+        uint32 ChunkQuads = MIN(Header.QuadCount - QuadIndex, RENDER_CHUNK_QUADS);
+        for(uint32 ChunkIndex = 0;
+            ChunkIndex < ChunkQuads;
+            ++ChunkIndex)
+        {
+            frame_capture_quad Quad;
+            CloverUnpackCaptureQuad(&Chunk->Instances[ChunkIndex], Chunk->SortKeys[ChunkIndex], &Quad);
+            fwrite(&Quad, sizeof(Quad), 1, File);
+        }
+        QuadIndex += ChunkQuads;
+    }
+
+    fwrite(RenderData->DrawFrame.PointLights, sizeof(point_light), Header.PointLightCount, File);
+    fwrite(RenderData->DrawFrame.SpotLights,  sizeof(spot_light),  Header.SpotLightCount,  File);
+    fclose(File);
+
+    printm("Captured %u quads to %s\n", Header.QuadCount, Filepath);
+    return(true);
+}
+
+internal bool8
+CloverLoadFrameCapture(memory_arena *Memory, const char *Filepath, frame_capture *Capture)
+{
+    bool8 Result = false;
+
+    FILE *File = fopen(Filepath, "rb");
+    if(File)
+    {
+        fseek(File, 0, SEEK_END);
+        uint64 FileSize = uint64(ftell(File));
+        fseek(File, 0, SEEK_SET);
+
+        frame_capture_header *Header = &Capture->Header;
+        if(fread(Header, sizeof(*Header), 1, File) == 1 &&
+           Header->Magic           == FRAME_CAPTURE_MAGIC   &&
+           Header->Version         == FRAME_CAPTURE_VERSION &&
+           Header->PointLightCount <= MAX_POINT_LIGHTS      &&
+           Header->SpotLightCount  <= MAX_SPOT_LIGHTS)
+        {
+            // NOTE(Sleepster): The counts have to account for the whole file and fit in what's left of the arena,
+            //                  otherwise a truncated or corrupt capture would take down PermanentStorage. Each of the
+            //                  three allocations carries one spare element and up to 8 bytes of alignment.
+            uint64 QuadBytes  = sizeof(frame_capture_quad) * uint64(Header->QuadCount);
+            uint64 LightBytes = (sizeof(point_light) * uint64(Header->PointLightCount)) +
+                                (sizeof(spot_light)  * uint64(Header->SpotLightCount));
+            uint64 AllocBytes = QuadBytes + LightBytes + sizeof(frame_capture_quad) + sizeof(point_light) + sizeof(spot_light) + (3 * 8);
+            if(sizeof(*Header) + QuadBytes + LightBytes == FileSize &&
+               AllocBytes <= Memory->Capacity - Memory->Used)
+            {
+                Capture->Quads       = (frame_capture_quad *)ArenaAlloc(Memory, sizeof(frame_capture_quad) * (Header->QuadCount + 1));
+                Capture->PointLights = (point_light *)ArenaAlloc(Memory, sizeof(point_light) * (Header->PointLightCount + 1));
+                Capture->SpotLights  = (spot_light  *)ArenaAlloc(Memory, sizeof(spot_light)  * (Header->SpotLightCount + 1));
+
+                Result = fread(Capture->Quads,       sizeof(frame_capture_quad), Header->QuadCount,       File) == Header->QuadCount       &&
+                         fread(Capture->PointLights, sizeof(point_light),        Header->PointLightCount, File) == Header->PointLightCount &&
+                         fread(Capture->SpotLights,  sizeof(spot_light),         Header->SpotLightCount,  File) == Header->SpotLightCount;
+            }
+        }
+        fclose(File);
+    }
+
+    if(!Result)
+    {
+        Trace("Failed to load the frame capture, it's from an older version or truncated/corrupt\n");
+    }
+    return(Result);
+}
+
+// NOTE(Sleepster): Puts DrawFrame back the way the game left it, the frame arena has to be reset before each submit
+internal void
+CloverSubmitFrameCapture(gl_render_data *RenderData, frame_capture *Capture)
+{
+    frame_capture_header *Header = &Capture->Header;
+    CloverResetRendererState(RenderData);
+
+    for(uint32 QuadIndex = 0;
+        QuadIndex < Header->QuadCount;
+        ++QuadIndex)
+    {
+        if((QuadIndex & RENDER_CHUNK_MASK) == 0)
+        {
+            render_chunk *Chunk = (render_chunk *)ArenaAlloc(RenderData->FrameArena, sizeof(render_chunk));
+            Assert(Chunk);
+            Chunk->Next = 0;
+
+            if(RenderData->DrawFrame.CurrentChunk)
+            {
+                RenderData->DrawFrame.CurrentChunk->Next = Chunk;
+            }
+            else
+            {
+                RenderData->DrawFrame.FirstChunk = Chunk;
+            }
+            RenderData->DrawFrame.CurrentChunk = Chunk;
+            ++RenderData->DrawFrame.ChunkCount;
+        }
+
+        frame_capture_quad *Captured = &Capture->Quads[QuadIndex];
+        quad Quad = {};
+        Quad.TopLeft.TextureCoords     = Captured->AtlasMin;
+        Quad.BottomRight.TextureCoords = Captured->AtlasMax;
+        Quad.DrawColor                 = Captured->Color;
+        Quad.TextureIndex              = real32(Captured->TextureIndex);
+        Quad.AnimParams                = Captured->AnimParams;
+        Quad.Layer                     = Captured->Layer;
+        Quad.Flags                     = Captured->Flags;
+
+        render_chunk *Chunk = RenderData->DrawFrame.CurrentChunk;
+        PackSpriteInstance(&Chunk->Instances[QuadIndex & RENDER_CHUNK_MASK], &Quad, Captured->Position, Captured->Size, Captured->Rotation);
+        Chunk->SortKeys[QuadIndex & RENDER_CHUNK_MASK] = MakeRenderSortKey(render_pass(Captured->Pass), Captured->Layer, Captured->TextureIndex, QuadIndex);
+    }
+    RenderData->DrawFrame.QueuedQuadCount = Header->QuadCount;
+
+    memcpy(RenderData->DrawFrame.PointLights, Capture->PointLights, sizeof(point_light) * Header->PointLightCount);
+    memcpy(RenderData->DrawFrame.SpotLights,  Capture->SpotLights,  sizeof(spot_light)  * Header->SpotLightCount);
+    RenderData->DrawFrame.PointLightCount = int32(Header->PointLightCount);
+    RenderData->DrawFrame.SpotLightCount  = int32(Header->SpotLightCount);
+
+    RenderData->GameCamera.ProjectionMatrix   = Header->GameProjection;
+    RenderData->GameCamera.ViewMatrix         = Header->GameView;
+    RenderData->GameUICamera.ProjectionMatrix = Header->UIProjection;
+    RenderData->GameUICamera.ViewMatrix       = Header->UIView;
+    RenderData->ClearColor                    = Header->ClearColor;
+    RenderData->AnimationTime                 = Header->AnimationTime;
+    RenderBrightness                          = Header->Brightness;
+}
+
+// NOTE(Sleepster): Every frame waits on glFinish so the totals are whole frames and the pass queries are always ready
+//                  by the next one. The per pass numbers average the last RENDER_TIMER_HISTORY frames.
+internal void
+CloverReplayFrameCapture(gl_render_data *RenderData, frame_capture *Capture, uint32 FrameCount)
+{
+    bool8 Software = RenderData->Software.Enabled;
+    if(Capture->Header.ViewportWidth != SizeData.Width || Capture->Header.ViewportHeight != SizeData.Height)
+    {
+        Trace("The capture was taken at a different window size, fill rate numbers won't compare\n");
+    }
+
+    real64 TotalSeconds   = 0.0;
+    real64 FastestSeconds = 0.0;
+    for(uint32 Frame = 0;
+        Frame < FrameCount;
+        ++Frame)
+    {
+        ArenaReset(RenderData->FrameArena);
+        CloverSubmitFrameCapture(RenderData, Capture);
+
+        LARGE_INTEGER StartCounter;
+        QueryPerformanceCounter(&StartCounter);
+
+        RenderData->CloverRender(RenderData);
+        if(!Software)
+        {
+            glFinish();
+        }
+
+        LARGE_INTEGER EndCounter;
+        QueryPerformanceCounter(&EndCounter);
+
+        real64 Seconds = real64(EndCounter.QuadPart - StartCounter.QuadPart) / real64(PerfCountFrequency);
+        TotalSeconds  += Seconds;
+        if(Frame == 0 || Seconds < FastestSeconds)
+        {
+            FastestSeconds = Seconds;
+        }
+    }
+
+    printm("Replayed %u frames of %u quads: %.3fms average, %.3fms fastest\n",
+           FrameCount, Capture->Header.QuadCount, (TotalSeconds * 1000.0) / real64(FrameCount), FastestSeconds * 1000.0);
+
+    if(!Software)
+    {
+        render_timers *Timers  = &RenderData->Timers;
+        uint32         Samples = MIN(FrameCount, uint32(RENDER_TIMER_HISTORY));
+        for(uint32 Timer = 0;
+            Timer < RENDER_TIMER_Count;
+            ++Timer)
+        {
+            real64 GPUMilliseconds = 0.0;
+            real64 CPUMilliseconds = 0.0;
+            for(uint32 Sample = 1;
+                Sample <= Samples;
+                ++Sample)
+            {
+                uint32 HistoryIndex = (Timers->HistoryIndex + RENDER_TIMER_HISTORY - Sample) % RENDER_TIMER_HISTORY;
+                GPUMilliseconds += Timers->GPUMilliseconds[Timer][HistoryIndex];
+                CPUMilliseconds += Timers->CPUMilliseconds[Timer][HistoryIndex];
+            }
+            printm("  %-16s GPU %.3fms  CPU %.3fms\n", RenderTimerNames[Timer], GPUMilliseconds / Samples, CPUMilliseconds / Samples);
+        }
+    }
+    else
+    {
+        printm("  Software: %.0f quads/sec\n", RenderData->Software.QuadsPerSecond);
+    }
+}
@@ -0,0 +1,72 @@
+#if !defined(CLOVER_CAPTURE_H)
+/* ========================================================================
+   $File: Clover_Capture.h $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define CLOVER_CAPTURE_H
+
+#include "Intrinsics.h"
+#include "Clover_Globals.h"
+#include "util/Math.h"
+#include "util/MemoryArena.h"
+
+// NOTE(Sleepster): A capture is one frame's DrawFrame written to disk right before it's rendered. "-capture N" grabs frame N,
+//                  the debug window's button grabs the next one. "-replay <file>" skips the game and pushes the capture
+//                  through RenderData->CloverRender "-frames N" times, then prints the pass timings.
+//                  Replay never loads fonts, so the glyph cache stays empty and text quads are still drawn and blended
+//                  but sample nothing. Their cost shows up in the timings, what they look like doesn't.
+#define FRAME_CAPTURE_DIRECTORY     "../data/cache/captures"
+#define FRAME_CAPTURE_MAGIC         0x43464C43 // "CLFC"
+#define FRAME_CAPTURE_VERSION       1
+#define FRAME_REPLAY_DEFAULT_FRAMES 500
+
+// NOTE(Sleepster): Quads are stored unpacked with their pass and layer instead of as sprite_instances and sort keys,
+//                  replaying re-packs them with whatever PackSpriteInstance and MakeRenderSortKey are now. That's what lets
+//                  an old capture A/B a new instance format or sort order.
+struct frame_capture_quad
+{
+    vec2   Position;
+    vec2   Size;
+    real32 Rotation;
+    vec4   Color;
+    vec2   AtlasMin;
+    vec2   AtlasMax;
+    vec3   AnimParams;
+
+    uint8  TextureIndex;
+    uint8  Flags;
+    uint8  Layer;
+    uint8  Pass;
+};
+
+struct frame_capture_header
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 QuadCount;
+    uint32 PointLightCount;
+    uint32 SpotLightCount;
+    int32  ViewportWidth;
+    int32  ViewportHeight;
+    real32 AnimationTime;
+    real32 Brightness;
+    vec4   ClearColor;
+
+    mat4   GameProjection;
+    mat4   GameView;
+    mat4   UIProjection;
+    mat4   UIView;
+};
+
+struct frame_capture
+{
+    frame_capture_header Header;
+    frame_capture_quad  *Quads;
+    point_light         *PointLights;
+    spot_light          *SpotLights;
+};
+
+#endif // CLOVER_CAPTURE_H
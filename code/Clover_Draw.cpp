@@ -41,6 +41,53 @@ DrawImGui(game_state *State, gl_render_data *RenderData, time Time)
         ImGui::Text("Famerate: %i", Time.FPSCounter);
         ImGui::Text("FrameTime: %.02f", Time.MSPerFrame);
         ImGui::Separator();
+
+        // NOTE(Sleepster): CPU is the time spent issuing the pass, GPU is the GL_TIME_ELAPSED from a frame or two back
+        render_timers *Timers = &RenderData->Timers;
+        uint32 NewestSample = (Timers->HistoryIndex + RENDER_TIMER_HISTORY - 1) % RENDER_TIMER_HISTORY;
+        ImGui::Text("Render Passes:");
+        for(uint32 Timer = 0;
+            Timer < RENDER_TIMER_Count;
+            ++Timer)
+        {
+            char Overlay[64] = {};
+            snprintf(Overlay, sizeof(Overlay), "GPU %.3fms  CPU %.3fms",
+                     Timers->GPUMilliseconds[Timer][NewestSample],
+                     Timers->CPUMilliseconds[Timer][NewestSample]);
+            ImGui::PlotLines(RenderTimerNames[Timer], Timers->GPUMilliseconds[Timer], RENDER_TIMER_HISTORY, 
+                             int32(Timers->HistoryIndex), Overlay, 0.0f, FLT_MAX, ImVec2(0, 40));
+        }
+        if(ImGui::Button("Capture Frame"))
+        {
+            RenderData->CaptureRequested = true;
+        }
+        ImGui::Separator();
+
+        ImGui::Text("Entity Systems:");
+        for(uint32 ArchIndex = 0;
+            ArchIndex < ARCH_ID_MAX;
+            ++ArchIndex)
+        {
+            if(State->GameData.EntitySystemCounts[ArchIndex])
+            {
+                ImGui::Text("Arch %2u: %5u entities, %5u visible, %10llu cycles",
+                            ArchIndex,
+                            State->GameData.EntitySystemCounts[ArchIndex],
+                            State->GameData.EntitySystemVisible[ArchIndex],
+                            State->GameData.EntitySystemCycles[ArchIndex]);
+            }
+        }
+        ImGui::Separator();
+
+        ImGui::Text("Glyph Cache: %u cached, %u rasterized, %u pages evicted",
+                    RenderData->GlyphCache.CachedGlyphCount,
+                    RenderData->GlyphCache.GlyphsRasterized,
+                    RenderData->GlyphCache.PagesEvicted);
+        ImGui::Text("Text Layouts: %u cached, %u hits, %u misses",
+                    RenderData->TextLayouts.LayoutCount,
+                    RenderData->TextLayouts.Hits,
+                    RenderData->TextLayouts.Misses);
+        ImGui::Separator();
         
         ImGui::Text("Clear Color:");
         ImGui::ColorPicker4("ClearColor", &RenderData->ClearColor.R, ImGuiColorEditFlags_PickerHueWheel);
@@ -122,178 +169,201 @@ CreateDrawRect(gl_render_data *RenderData, vec2 Size, real32 Rotation, vec4 Colo
     return(Quad);
 }
 
-internal quad *
-DrawQuadXForm(gl_render_data *RenderData, quad *Quad, mat4 *Transform, bool IsFont)
+// NOTE(Sleepster): Pulls Translation * Rotation * Scale back out of an affine. Instances can't represent shear,
+//                  a mirrored transform keeps its flip as a negative Y size. Axis aligned transforms (everything
+//                  the UI builds) skip the square roots and the atan2.
+internal inline void
+DecomposeSpriteAffine(affine2d *Transform, vec2 *Center, vec2 *Size, real32 *Rotation)
 {
-    if(RenderData->DrawFrame.TotalQuadCount >= MAX_QUADS * 0.5f)
+    vec2 AxisX = Transform->X;
+    vec2 AxisY = Transform->Y;
+    
+    *Center = Transform->Offset;
+    if(AxisX.Y == 0.0f && AxisY.X == 0.0f)
     {
-        RenderData->CloverRender(RenderData);
+        *Size     = vec2{AxisX.X, AxisY.Y};
+        *Rotation = 0.0f;
     }
+    else
+    {
+        real32 Determinant = affine2dDeterminant(*Transform);
+        *Size     = vec2{v2Length(AxisX), Determinant < 0.0f ? -v2Length(AxisY) : v2Length(AxisY)};
+        *Rotation = atan2f(AxisX.Y, AxisX.X);
+    }
+}
+
+internal void
+AppendRenderChunk(gl_render_data *RenderData)
+{
+    render_chunk *Chunk = (render_chunk *)ArenaAlloc(RenderData->FrameArena, sizeof(render_chunk));
+    Assert(Chunk);
+    Chunk->Next = 0;
     
-    Quad->Elements[0].Position = vec4{-0.5f,  0.5f, 0.0f, 1.0f};
-    Quad->Elements[1].Position = vec4{ 0.5f,  0.5f, 0.0f, 1.0f};
-    Quad->Elements[2].Position = vec4{ 0.5f, -0.5f, 0.0f, 1.0f};
-    Quad->Elements[3].Position = vec4{-0.5f, -0.5f, 0.0f, 1.0f};
-    
-    Quad->Elements[0].Position = mat4Transform(*Transform, Quad->Elements[0].Position);
-    Quad->Elements[1].Position = mat4Transform(*Transform, Quad->Elements[1].Position);
-    Quad->Elements[2].Position = mat4Transform(*Transform, Quad->Elements[2].Position);
-    Quad->Elements[3].Position = mat4Transform(*Transform, Quad->Elements[3].Position);
-
-    vec3 Normals = {0, 0, 1};
-    mat3 NormalMatrix = mat3Transpose(mat3Inverse(mat3FromMat4(*Transform)));
-    vec3 ComputedNormals = mat3Transform(NormalMatrix, Normals);
-
-    Quad->TopLeft.VertexNormals     = ComputedNormals; 
-    Quad->TopRight.VertexNormals    = ComputedNormals;
-    Quad->BottomLeft.VertexNormals  = ComputedNormals;
-    Quad->BottomRight.VertexNormals = ComputedNormals;
-    
-    vertex **VertexBufferptr;
-    uint32  *ElementCounter;
-    
+    if(RenderData->DrawFrame.CurrentChunk)
+    {
+        RenderData->DrawFrame.CurrentChunk->Next = Chunk;
+    }
+    else
+    {
+        RenderData->DrawFrame.FirstChunk = Chunk;
+    }
+    RenderData->DrawFrame.CurrentChunk = Chunk;
+    ++RenderData->DrawFrame.ChunkCount;
+}
+
+// NOTE(Sleepster): Packs the instance and its sort key into a slot that's already been handed out, touches nothing shared
+internal inline void
+WriteQuadInstance(render_chunk *Chunk, uint32 SubmissionIndex, quad *Quad, vec2 Center, vec2 Size, real32 Rotation, bool IsFont, bool IsUI)
+{
+    render_pass Pass;
     bool IsOpaque = (Quad->DrawColor.A == 1.0f && !IsFont);
-    if(IsOpaque)
+    if(IsUI)
     {
-        VertexBufferptr = &RenderData->DrawFrame.VertexBufferptr;
-        ElementCounter  = &RenderData->DrawFrame.OpaqueQuadCount;
+        Pass = IsOpaque ? RENDER_PASS_UIOpaque : RENDER_PASS_UITransparent;
     }
     else
     {
-        VertexBufferptr = &RenderData->DrawFrame.TransparentVertexBufferptr;
-        ElementCounter  = &RenderData->DrawFrame.TransparentQuadCount;
+        Pass = IsOpaque ? RENDER_PASS_GameOpaque : RENDER_PASS_GameTransparent;
     }
     
-    // TOP LEFT
-    (*VertexBufferptr)->Position      = Quad->Elements[0].Position;
-    (*VertexBufferptr)->TextureCoords = Quad->TopLeft.TextureCoords;
-    (*VertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*VertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*VertexBufferptr)++;
-    
-    
-    (*VertexBufferptr)->Position      = Quad->Elements[1].Position;
-    (*VertexBufferptr)->TextureCoords = Quad->TopRight.TextureCoords;
-    (*VertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*VertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*VertexBufferptr)++;
-    
-    
-    (*VertexBufferptr)->Position      = Quad->Elements[2].Position;
-    (*VertexBufferptr)->TextureCoords = Quad->BottomRight.TextureCoords;
-    (*VertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*VertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*VertexBufferptr)++;
-    
-    
-    (*VertexBufferptr)->Position      = Quad->Elements[3].Position;
-    (*VertexBufferptr)->TextureCoords = Quad->BottomLeft.TextureCoords;
-    (*VertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*VertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*VertexBufferptr)++;
+    if(IsFont)
+    {
+        Quad->Flags |= RENDERING_OPTION_FONT;
+    }
     
-    (*ElementCounter)++;
-    RenderData->DrawFrame.TotalQuadCount++;
-    return(Quad);
+    PackSpriteInstance(&Chunk->Instances[SubmissionIndex & RENDER_CHUNK_MASK], Quad, Center, Size, Rotation);
+    Chunk->SortKeys[SubmissionIndex & RENDER_CHUNK_MASK] = MakeRenderSortKey(Pass, Quad->Layer, uint8(Quad->TextureIndex), SubmissionIndex);
 }
 
-
+// NOTE(Sleepster): Queues the instance with its sort key, nothing is ordered or uploaded until the end of the frame.
+//                  A full chunk just chains a new one off the frame arena.
 internal quad *
-DrawUIQuadXForm(gl_render_data *RenderData, quad *Quad, mat4 *Transform, bool IsFont)
+PushQuadInstance(gl_render_data *RenderData, quad *Quad, vec2 Center, vec2 Size, real32 Rotation, bool IsFont, bool IsUI)
 {
-    if(RenderData->DrawFrame.TotalUIElementCount >= MAX_QUADS * 0.5f)
+    uint32 SubmissionIndex = RenderData->DrawFrame.QueuedQuadCount;
+    if((SubmissionIndex & RENDER_CHUNK_MASK) == 0)
     {
-        RenderData->CloverRender(RenderData);
+        AppendRenderChunk(RenderData);
     }
     
-    Quad->Elements[0].Position = vec4{-0.5f,  0.5f, 0.0f, 1.0f};
-    Quad->Elements[1].Position = vec4{ 0.5f,  0.5f, 0.0f, 1.0f};
-    Quad->Elements[2].Position = vec4{ 0.5f, -0.5f, 0.0f, 1.0f};
-    Quad->Elements[3].Position = vec4{-0.5f, -0.5f, 0.0f, 1.0f};
+    WriteQuadInstance(RenderData->DrawFrame.CurrentChunk, SubmissionIndex, Quad, Center, Size, Rotation, IsFont, IsUI);
+    ++RenderData->DrawFrame.QueuedQuadCount;
     
-    Quad->Elements[0].Position = mat4Transform(*Transform, Quad->Elements[0].Position);
-    Quad->Elements[1].Position = mat4Transform(*Transform, Quad->Elements[1].Position);
-    Quad->Elements[2].Position = mat4Transform(*Transform, Quad->Elements[2].Position);
-    Quad->Elements[3].Position = mat4Transform(*Transform, Quad->Elements[3].Position);
-
-    vec3 Normals = {0, 0, 1};
-
-    Quad->TopLeft.VertexNormals     = v4Normalize(mat4Transform(*Transform, v3Expand(Normals, 1.0))).XYZ; 
-    Quad->TopRight.VertexNormals    = v4Normalize(mat4Transform(*Transform, v3Expand(Normals, 1.0))).XYZ;
-    Quad->BottomLeft.VertexNormals  = v4Normalize(mat4Transform(*Transform, v3Expand(Normals, 1.0))).XYZ;
-    Quad->BottomRight.VertexNormals = v4Normalize(mat4Transform(*Transform, v3Expand(Normals, 1.0))).XYZ;
+    return(Quad);
+}
 
+// NOTE(Sleepster): Main thread only. Every chunk the slab spans is chained up front, the workers never allocate.
+internal quad_slab
+ReserveQuadSlab(gl_render_data *RenderData, uint32 Count)
+{
+    quad_slab Slab = {};
+    Slab.First = RenderData->DrawFrame.QueuedQuadCount;
+    Slab.Count = Count;
+    if(Count > 0)
+    {
+        if((Slab.First & RENDER_CHUNK_MASK) == 0)
+        {
+            AppendRenderChunk(RenderData);
+        }
+        Slab.FirstChunk = RenderData->DrawFrame.CurrentChunk;
+        
+        uint32 OnePastLast = Slab.First + Count;
+        while((RenderData->DrawFrame.ChunkCount << RENDER_CHUNK_SHIFT) < OnePastLast)
+        {
+            AppendRenderChunk(RenderData);
+        }
+        RenderData->DrawFrame.QueuedQuadCount = OnePastLast;
+    }
     
-    vertex **UIVertexBufferptr;
-    uint32  *ElementCounter;
+    return(Slab);
+}
+
+internal quad_slab_writer
+BeginQuadSlabWrite(quad_slab *Slab, uint32 SlabOffset)
+{
+    quad_slab_writer Writer = {};
+    Writer.Chunk           = Slab->FirstChunk;
+    Writer.SubmissionIndex = Slab->First + SlabOffset;
     
-    bool IsOpaque = (Quad->DrawColor.A == 1.0f && !IsFont);
-    if(IsOpaque)
+    uint32 ChunksToSkip = (Writer.SubmissionIndex >> RENDER_CHUNK_SHIFT) - (Slab->First >> RENDER_CHUNK_SHIFT);
+    while(ChunksToSkip--)
     {
-        UIVertexBufferptr = &RenderData->DrawFrame.UIVertexBufferptr;
-        ElementCounter    = &RenderData->DrawFrame.OpaqueUIElementCount;
+        Writer.Chunk = Writer.Chunk->Next;
     }
-    else
+    
+    return(Writer);
+}
+
+internal quad *
+PushSlabQuadInstance(quad_slab_writer *Writer, quad *Quad, vec2 Center, vec2 Size, real32 Rotation, bool IsFont, bool IsUI)
+{
+    WriteQuadInstance(Writer->Chunk, Writer->SubmissionIndex, Quad, Center, Size, Rotation, IsFont, IsUI);
+    if((++Writer->SubmissionIndex & RENDER_CHUNK_MASK) == 0)
     {
-        UIVertexBufferptr = &RenderData->DrawFrame.TransparentUIVertexBufferptr;
-        ElementCounter    = &RenderData->DrawFrame.TransparentUIElementCount;
+        Writer->Chunk = Writer->Chunk->Next;
     }
     
-    // TOP LEFT
-    (*UIVertexBufferptr)->Position      = Quad->Elements[0].Position;
-    (*UIVertexBufferptr)->TextureCoords = Quad->TopLeft.TextureCoords;
-    (*UIVertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*UIVertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*UIVertexBufferptr)++;
-    
-    
-    (*UIVertexBufferptr)->Position      = Quad->Elements[1].Position;
-    (*UIVertexBufferptr)->TextureCoords = Quad->TopRight.TextureCoords;
-    (*UIVertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*UIVertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*UIVertexBufferptr)++;
-    
-    
-    (*UIVertexBufferptr)->Position      = Quad->Elements[2].Position;
-    (*UIVertexBufferptr)->TextureCoords = Quad->BottomRight.TextureCoords;
-    (*UIVertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*UIVertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*UIVertexBufferptr)++;
-    
-    
-    (*UIVertexBufferptr)->Position      = Quad->Elements[3].Position;
-    (*UIVertexBufferptr)->TextureCoords = Quad->BottomLeft.TextureCoords;
-    (*UIVertexBufferptr)->DrawColor     = Quad->DrawColor;
-    (*UIVertexBufferptr)->TextureIndex  = Quad->TextureIndex;
-    (*UIVertexBufferptr)++;
-    
-    (*ElementCounter)++;
-    RenderData->DrawFrame.TotalUIElementCount++;
     return(Quad);
 }
 
 internal quad *
-DrawQuadProjected(gl_render_data *RenderData, quad *Quad, bool IsFont)
+DrawQuadAffine(gl_render_data *RenderData, quad *Quad, affine2d *Transform, bool IsFont)
 {
-    mat4 Translation = mat4Multiply(mat4Identity(1.0f), mat4Translate(v2Expand(vec2{Quad->Position.X, Quad->Position.Y + (Quad->Size.Y * 0.5f)}, 0.0f)));
-    mat4 Rotation    = mat4Multiply(mat4Identity(1.0f), mat4RHRotate(AngleRad(Quad->Rotation), vec3{0.0f, 0.0f, 1.0f}));
-    mat4 Scale       = mat4MakeScale(v2Expand(Quad->Size, 1.0f));
+    vec2   Center;
+    vec2   Size;
+    real32 Rotation;
+    DecomposeSpriteAffine(Transform, &Center, &Size, &Rotation);
     
-    mat4 Transform = Translation * Rotation * Scale;
+    return(PushQuadInstance(RenderData, Quad, Center, Size, Rotation, IsFont, false));
+}
+
+internal quad *
+DrawUIQuadAffine(gl_render_data *RenderData, quad *Quad, affine2d *Transform, bool IsFont)
+{
+    vec2   Center;
+    vec2   Size;
+    real32 Rotation;
+    DecomposeSpriteAffine(Transform, &Center, &Size, &Rotation);
     
-    return(DrawQuadXForm(RenderData, Quad, &Transform, IsFont));
+    return(PushQuadInstance(RenderData, Quad, Center, Size, Rotation, IsFont, true));
+}
+
+// NOTE(Sleepster): mat4 XForms are only ever built from 2D translations, rotations and scales so they drop straight to an affine
+internal quad *
+DrawQuadXForm(gl_render_data *RenderData, quad *Quad, mat4 *Transform, bool IsFont)
+{
+    affine2d Affine = affine2dFromMat4(*Transform);
+    return(DrawQuadAffine(RenderData, Quad, &Affine, IsFont));
+}
+
+internal quad *
+DrawUIQuadXForm(gl_render_data *RenderData, quad *Quad, mat4 *Transform, bool IsFont)
+{
+    affine2d Affine = affine2dFromMat4(*Transform);
+    return(DrawUIQuadAffine(RenderData, Quad, &Affine, IsFont));
+}
+
+// NOTE(Sleepster): Projected quads are just Translation * Rotation * Scale, the instance stores those directly
+//                  so there's no transform to build at all
+internal quad *
+DrawQuadProjected(gl_render_data *RenderData, quad *Quad, bool IsFont)
+{
+    vec2 Center = vec2{Quad->Position.X, Quad->Position.Y + (Quad->Size.Y * 0.5f)};
+    return(PushQuadInstance(RenderData, Quad, Center, Quad->Size, AngleRad(Quad->Rotation), IsFont, false));
 }
 
 internal quad *
 DrawUIQuadProjected(gl_render_data *RenderData, quad *Quad, bool IsFont)
 {
-    mat4 Translation = mat4Multiply(mat4Identity(1.0f), mat4Translate(v2Expand(vec2{Quad->Position.X - (Quad->Size.X * 0.5f), Quad->Position.Y + (Quad->Size.Y * 0.5f)}, 0.0f)));
-    mat4 Rotation    = mat4Multiply(mat4Identity(1.0f), mat4RHRotate(AngleRad(Quad->Rotation), vec3{0.0f, 0.0f, 1.0f}));
-    mat4 Scale       = mat4MakeScale(v2Expand(Quad->Size, 1.0f));
-    
-    mat4 Transform = Translation * Rotation * Scale;
-    
-    return(DrawUIQuadXForm(RenderData, Quad, &Transform, IsFont));
+    vec2 Center = vec2{Quad->Position.X - (Quad->Size.X * 0.5f), Quad->Position.Y + (Quad->Size.Y * 0.5f)};
+    return(PushQuadInstance(RenderData, Quad, Center, Quad->Size, AngleRad(Quad->Rotation), IsFont, true));
+}
+
+internal quad *
+DrawSlabQuadProjected(quad_slab_writer *Writer, quad *Quad, bool IsFont)
+{
+    vec2 Center = vec2{Quad->Position.X, Quad->Position.Y + (Quad->Size.Y * 0.5f)};
+    return(PushSlabQuadInstance(Writer, Quad, Center, Quad->Size, AngleRad(Quad->Rotation), IsFont, false));
 }
 
 internal quad*
@@ -342,6 +412,33 @@ DrawUIQuad(gl_render_data *RenderData, vec2 Position, vec2 Size, real32 Rotation
     return(DrawUIQuadProjected(RenderData, &Quad, IsFont));
 }
 
+// NOTE(Sleepster): Looks a sprite up by its file name in the packed atlas, missing sprites fall back to the blank one
+internal static_sprite_data
+GetAtlasSprite(gl_render_data *RenderData, const char *Name)
+{
+    static_sprite_data Result = {.AtlasOffset = {0, 0}, .SpriteSize = {16, 16}, .AtlasPage = 0};
+    for(uint32 SpriteIndex = 0;
+        SpriteIndex < RenderData->AtlasSpriteCount;
+        ++SpriteIndex)
+    {
+        sprite_atlas_entry *Entry = &RenderData->AtlasSprites[SpriteIndex];
+        if(strcmp(Entry->Name, Name) == 0 && Entry->Width > 0)
+        {
+            Result.AtlasOffset = {Entry->X, Entry->Y};
+            Result.SpriteSize  = {Entry->Width, Entry->Height};
+            Result.AtlasPage   = Entry->Page;
+            return(Result);
+        }
+    }
+
+    // NOTE(Sleepster): An empty table just means the atlas build hasn't landed yet
+    if(RenderData->AtlasSpriteCount > 0)
+    {
+        Trace("Sprite is missing from the atlas, using the blank sprite\n");
+    }
+    return(Result);
+}
+
 internal inline static_sprite_data
 GetSprite(game_state *State, sprite_type Sprite)
 {
@@ -354,8 +451,7 @@ DrawSprite(gl_render_data    *RenderData,
            vec2               Position, 
            vec2               RenderSize, 
            vec4               Color, 
-           real32             Rotation,
-           uint32             TextureIndex)
+           real32             Rotation)
 {    
     return(DrawQuadTextured(RenderData, 
                             Position, 
@@ -364,7 +460,7 @@ DrawSprite(gl_render_data    *RenderData,
                             SpriteData.SpriteSize, 
                             Rotation, 
                             Color, 
-                            TextureIndex,
+                            SpriteData.AtlasPage,
                             0));
 }
 
@@ -372,7 +468,39 @@ internal quad *
 DrawEntity(gl_render_data *RenderData, game_state *State, entity *Entity, vec2 Position, vec4 Color)
 {
     static_sprite_data SpriteData = State->GameData.Sprites[Entity->Sprite];
-    return(DrawSprite(RenderData, SpriteData, Entity->Position, Entity->Size, Color, Entity->Rotation, 0));
+    return(DrawSprite(RenderData, SpriteData, Entity->Position, Entity->Size, Color, Entity->Rotation));
+}
+
+// NOTE(Sleepster): Same as DrawSprite and DrawEntity, but into a reserved slab so they're safe to call from a worker
+internal inline quad *
+DrawSlabSprite(quad_slab_writer *Writer, static_sprite_data SpriteData, vec2 Position, vec2 RenderSize, vec4 Color, real32 Rotation)
+{
+    quad Quad = CreateDrawQuad(0, Position, RenderSize, SpriteData.SpriteSize, SpriteData.AtlasOffset, Rotation, Color, real32(SpriteData.AtlasPage));
+    return(DrawSlabQuadProjected(Writer, &Quad, 0));
+}
+
+internal quad *
+DrawSlabEntity(quad_slab_writer *Writer, game_state *State, entity *Entity, vec4 Color)
+{
+    static_sprite_data SpriteData = State->GameData.Sprites[Entity->Sprite];
+    return(DrawSlabSprite(Writer, SpriteData, Entity->Position, Entity->Size, Color, Entity->Rotation));
+}
+
+// NOTE(Sleepster): AnimParams is (Phase, Amplitude, Frequency), the offset is applied on the GPU so the entity's position never changes
+internal quad *
+DrawEntityAnimated(gl_render_data *RenderData, game_state *State, entity *Entity, vec4 Color, vec3 AnimParams)
+{
+    static_sprite_data SpriteData = State->GameData.Sprites[Entity->Sprite];
+    quad Quad = CreateDrawQuad(RenderData, 
+                               Entity->Position, 
+                               Entity->Size, 
+                               SpriteData.SpriteSize, 
+                               SpriteData.AtlasOffset, 
+                               Entity->Rotation, 
+                               Color, 
+                               SpriteData.AtlasPage);
+    Quad.AnimParams = AnimParams;
+    return(DrawQuadProjected(RenderData, &Quad, 0));
 }
 
 
@@ -382,8 +510,7 @@ DrawUISprite(gl_render_data     *RenderData,
              vec2                Position,
              vec2                RenderSize,
              vec4                Color,
-             real32              Rotation,
-             uint32              TextureIndex)
+             real32              Rotation)
 {
     return(DrawUIQuadTextured(RenderData, 
                               Position, 
@@ -392,7 +519,7 @@ DrawUISprite(gl_render_data     *RenderData,
                               SpriteData.SpriteSize, 
                               Rotation, 
                               Color, 
-                              TextureIndex,
+                              SpriteData.AtlasPage,
                               0));
 }
 
@@ -404,7 +531,7 @@ DrawUIEntity(gl_render_data *RenderData,
              vec4            Color)
 {
     static_sprite_data SpriteData = State->GameData.Sprites[Entity->Sprite];
-    return(DrawUISprite(RenderData, SpriteData, Entity->Position, v2Cast(SpriteData.SpriteSize), Color, Entity->Rotation, 0));
+    return(DrawUISprite(RenderData, SpriteData, Entity->Position, v2Cast(SpriteData.SpriteSize), Color, Entity->Rotation));
 }
 
 internal void
@@ -423,7 +550,7 @@ DrawUIRectXForm(gl_render_data *RenderData, mat4 XForm, vec2 Size, real32 Rotati
 
 internal quad*
 DrawUISpriteXForm(gl_render_data    *RenderData, 
-                  mat4               XForm, 
+                  affine2d           XForm, 
                   static_sprite_data Sprite,
                   real32             Rotation, 
                   vec4               Color)
@@ -435,13 +562,13 @@ DrawUISpriteXForm(gl_render_data    *RenderData,
                                Sprite.AtlasOffset, 
                                Rotation, 
                                Color, 
-                               0); 
-    return(DrawUIQuadXForm(RenderData, &Quad, &XForm, 0));
+                               Sprite.AtlasPage); 
+    return(DrawUIQuadAffine(RenderData, &Quad, &XForm, 0));
 }
 
 internal quad* 
 DrawSpriteXForm(gl_render_data    *RenderData, 
-                mat4               XForm, 
+                affine2d           XForm, 
                 static_sprite_data Sprite,
                 real32             Rotation, 
                 vec4               Color)
@@ -453,8 +580,23 @@ DrawSpriteXForm(gl_render_data    *RenderData,
                                Sprite.AtlasOffset, 
                                Rotation, 
                                Color, 
-                               0); 
-    return(DrawQuadXForm(RenderData, &Quad, &XForm, 0));
+                               Sprite.AtlasPage); 
+    return(DrawQuadAffine(RenderData, &Quad, &XForm, 0));
+}
+
+// NOTE(Sleepster): Text drawn past the font's base size gets glyphs rasterized at a bigger size instead of stretching
+//                  the base ones
+internal inline uint32
+GetGlyphPixelSize(font_data *Font, real32 TrueScale)
+{
+    uint32 PixelSize = Font->FontSize;
+    real32 Requested = Font->FontSize * TrueScale;
+    if(Requested > real32(PixelSize))
+    {
+        uint32 Stepped = ((uint32(Requested) + GLYPH_SIZE_STEP - 1) / GLYPH_SIZE_STEP) * GLYPH_SIZE_STEP;
+        PixelSize = MAX(MIN(Stepped, MAX_GLYPH_PIXEL_SIZE), PixelSize);
+    }
+    return(PixelSize);
 }
 
 internal void
@@ -465,29 +607,217 @@ DrawGameText(gl_render_data *RenderData,
              font_index      Font, 
              vec4            Color) 
 {
-    vec2 TextOrigin = Position;
-    real32 TrueScale = FontScale / 100.0f;
-    
-    for(uint32 StringIndex = 0;
-        StringIndex < Text.Length;
-        ++StringIndex)
+    vec2       TextOrigin = Position;
+    real32     TrueScale  = FontScale / 100.0f;
+    font_data *FontData   = &RenderData->LoadedFonts[Font];
+    uint32     PixelSize  = GetGlyphPixelSize(FontData, TrueScale);
+    real32     GlyphScale = TrueScale * (real32(FontData->FontSize) / real32(PixelSize));
+    
+    for(uint64 StringIndex = 0;
+        StringIndex < Text.Length;)
     {
-        if(Text.Data[StringIndex] == '\n')    
+        uint32 Codepoint = DecodeUTF8(Text, &StringIndex);
+        if(Codepoint == '\n')    
         {
-            Position.Y += RenderData->LoadedFonts[Font].FontHeight * TrueScale;
+            Position.Y += FontData->FontHeight * TrueScale;
             Position.X = TextOrigin.X;
             continue;
         }
         
-        char C = (Text.Data[StringIndex]);
-        font_glyph Glyph = RenderData->LoadedFonts[Font].Glyphs[C];
-        
-        vec2  RenderScale   = {Glyph.GlyphSize.X * TrueScale, (real32)Glyph.GlyphSize.Y * (TrueScale * 2)};
-        ivec2 AtlasOffset   = Glyph.GlyphUVs;
-        ivec2 GlyphSize     = Glyph.GlyphSize;
-        
-        DrawQuadTextured(RenderData, Position, RenderScale, AtlasOffset, GlyphSize, 0.0f, Color, 1, 1);
-        Position.X += Glyph.GlyphAdvance.X * TrueScale;
+        font_glyph Glyph = RenderData->CloverGetGlyph(RenderData, Font, PixelSize, Codepoint);
+        if(Glyph.GlyphSize.X > 0)
+        {
+            vec2 RenderScale = {Glyph.GlyphSize.X * GlyphScale, (real32)Glyph.GlyphSize.Y * (GlyphScale * 2)};
+            DrawQuadTextured(RenderData, Position, RenderScale, Glyph.GlyphUVs, Glyph.GlyphSize, 0.0f, Color, Glyph.AtlasPage, 1);
+        }
+        Position.X += Glyph.GlyphAdvance.X * GlyphScale;
+    }
+}
+
+internal uint64
+HashTextLayoutKey(string Text, font_index Font, real32 FontScale)
+{
+    uint64 Hash = 0xCBF29CE484222325ull;
+    for(uint64 ByteIndex = 0;
+        ByteIndex < Text.Length;
+        ++ByteIndex)
+    {
+        Hash ^= Text.Data[ByteIndex];
+        Hash *= 0x100000001B3ull;
+    }
+
+    uint32 ScaleBits;
+    memcpy(&ScaleBits, &FontScale, sizeof(ScaleBits));
+    Hash ^= (uint64(Font) << 32) | ScaleBits;
+    Hash *= 0x100000001B3ull;
+    return(Hash);
+}
+
+// NOTE(Sleepster): The layout table sits at the front of the storage, everything after it is strings and instances
+internal void
+ResetTextLayoutCache(text_layout_cache *Cache)
+{
+    Cache->Storage.Used = sizeof(text_layout) * MAX_TEXT_LAYOUTS;
+    Cache->LayoutCount  = 0;
+    memset(Cache->Buckets, 0, sizeof(Cache->Buckets));
+}
+
+// NOTE(Sleepster): Same pen walk DrawUIText always did, the instances are packed relative to the text's origin
+internal void
+BuildTextLayout(gl_render_data *RenderData, text_layout *Layout)
+{
+    glyph_cache *Glyphs        = &RenderData->GlyphCache;
+    uint32       DroppedBefore = Glyphs->GlyphsDropped;
+
+    font_data *FontData   = &RenderData->LoadedFonts[Layout->Font];
+    real32     TrueScale  = Layout->FontScale / 100.0f;
+    uint32     PixelSize  = GetGlyphPixelSize(FontData, TrueScale);
+    real32     GlyphScale = TrueScale * (real32(FontData->FontSize) / real32(PixelSize));
+
+    vec2 Pen = {};
+    Layout->Extent        = {0, FontData->FontHeight * TrueScale};
+    Layout->InstanceCount = 0;
+    Layout->PageMask      = 0;
+    for(uint64 StringIndex = 0;
+        StringIndex < Layout->Text.Length;)
+    {
+        uint32 Codepoint = DecodeUTF8(Layout->Text, &StringIndex);
+        if(Codepoint == '\n')
+        {
+            Pen.Y += FontData->FontHeight * TrueScale;
+            Pen.X  = 0;
+            Layout->Extent.Y += FontData->FontHeight * TrueScale;
+            continue;
+        }
+
+        font_glyph Glyph = RenderData->CloverGetGlyph(RenderData, Layout->Font, PixelSize, Codepoint);
+        if(Glyph.GlyphSize.X > 0)
+        {
+            vec2 RenderScale = {Glyph.GlyphSize.X * GlyphScale, (real32)Glyph.GlyphSize.Y * (GlyphScale * 2)};
+            quad Quad = CreateDrawQuad(RenderData, Pen, RenderScale, Glyph.GlyphSize, Glyph.GlyphUVs, 0.0f, WHITE, real32(Glyph.AtlasPage));
+            Quad.Flags |= RENDERING_OPTION_FONT;
+
+            vec2 Center = vec2{Pen.X - (RenderScale.X * 0.5f), Pen.Y + (RenderScale.Y * 0.5f)};
+            PackSpriteInstance(&Layout->Instances[Layout->InstanceCount++], &Quad, Center, RenderScale, 0.0f);
+            Layout->PageMask |= (1 << Glyph.AtlasPage);
+        }
+        Pen.X            += Glyph.GlyphAdvance.X * GlyphScale;
+        Layout->Extent.X += Glyph.GlyphAdvance.X * GlyphScale;
+    }
+
+    // NOTE(Sleepster): A glyph that didn't fit this frame leaves a hole, the eviction count only goes up so
+    //                  this never matches again and the layout gets rebuilt next time it's asked for
+    Layout->PagesEvicted = Glyphs->PagesEvicted;
+    if(Glyphs->GlyphsDropped != DroppedBefore)
+    {
+        Layout->PagesEvicted -= 1;
+    }
+}
+
+internal text_layout *
+GetTextLayout(gl_render_data *RenderData, string Text, real32 FontScale, font_index Font)
+{
+    text_layout_cache *Cache  = &RenderData->TextLayouts;
+    uint64             Hash   = HashTextLayoutKey(Text, Font, FontScale);
+    uint32             Bucket = uint32(Hash) & (TEXT_LAYOUT_BUCKETS - 1);
+
+    text_layout *Layout = 0;
+    for(text_layout *Candidate = Cache->Buckets[Bucket];
+        Candidate;
+        Candidate = Candidate->NextInBucket)
+    {
+        if(Candidate->Hash == Hash && Candidate->Font == Font && Candidate->FontScale == FontScale && StringsMatch(Candidate->Text, Text))
+        {
+            Layout = Candidate;
+            break;
+        }
+    }
+
+    if(Layout && Layout->PagesEvicted == RenderData->GlyphCache.PagesEvicted)
+    {
+        ++Cache->Hits;
+        return(Layout);
+    }
+    ++Cache->Misses;
+
+    // NOTE(Sleepster): A stale layout is rebuilt in place, its instances already have room for the same string
+    if(!Layout)
+    {
+        uint64 InstanceBytes = (sizeof(sprite_instance) * Text.Length + 7) & ~7;
+        uint64 Needed        = ((Text.Length + 7) & ~7) + InstanceBytes;
+        if(Cache->LayoutCount == MAX_TEXT_LAYOUTS || Cache->Storage.Used + Needed > Cache->Storage.Capacity)
+        {
+            ResetTextLayoutCache(Cache);
+        }
+
+        if(Cache->Storage.Used + Needed > Cache->Storage.Capacity)
+        {
+            // NOTE(Sleepster): Bigger than the whole cache, lay it out for this frame only
+            Layout            = (text_layout *)ArenaAlloc(RenderData->FrameArena, sizeof(text_layout));
+            Layout->Text      = Text;
+            Layout->Instances = (sprite_instance *)ArenaAlloc(RenderData->FrameArena, InstanceBytes);
+        }
+        else
+        {
+            Layout                 = &Cache->Layouts[Cache->LayoutCount++];
+            Layout->Text           = StringCopy(Text, &Cache->Storage);
+            Layout->Instances      = (sprite_instance *)ArenaAlloc(&Cache->Storage, InstanceBytes);
+            Layout->NextInBucket   = Cache->Buckets[Bucket];
+            Cache->Buckets[Bucket] = Layout;
+        }
+        Layout->Hash      = Hash;
+        Layout->Font      = Font;
+        Layout->FontScale = FontScale;
+    }
+
+    BuildTextLayout(RenderData, Layout);
+    return(Layout);
+}
+
+// NOTE(Sleepster): The cached instances are copied into a reserved slab a chunk's worth at a time, only the
+//                  position, color and sort key get touched per glyph
+internal void
+DrawUITextLayout(gl_render_data *RenderData, text_layout *Layout, vec2 Position, vec4 Color)
+{
+    if(Layout->InstanceCount == 0) return;
+
+    glyph_cache *Glyphs = &RenderData->GlyphCache;
+    for(uint32 PageIndex = 0;
+        PageIndex < MAX_FONT_ATLAS_PAGES;
+        ++PageIndex)
+    {
+        if(Layout->PageMask & (1 << PageIndex))
+        {
+            Glyphs->AtlasPages[PageIndex].LastUsedFrame = Glyphs->Frame;
+        }
+    }
+
+    uint32           DrawColor = PackRGBA8(Color);
+    quad_slab        Slab      = ReserveQuadSlab(RenderData, Layout->InstanceCount);
+    quad_slab_writer Writer    = BeginQuadSlabWrite(&Slab, 0);
+    for(uint32 Copied = 0;
+        Copied < Layout->InstanceCount;)
+    {
+        uint32 Slot = Writer.SubmissionIndex & RENDER_CHUNK_MASK;
+        uint32 Run  = MIN(Layout->InstanceCount - Copied, RENDER_CHUNK_QUADS - Slot);
+        memcpy(&Writer.Chunk->Instances[Slot], &Layout->Instances[Copied], sizeof(sprite_instance) * Run);
+
+        for(uint32 RunIndex = 0;
+            RunIndex < Run;
+            ++RunIndex)
+        {
+            sprite_instance *Instance = &Writer.Chunk->Instances[Slot + RunIndex];
+            Instance->Position  = Instance->Position + Position;
+            Instance->DrawColor = DrawColor;
+            Writer.Chunk->SortKeys[Slot + RunIndex] = MakeRenderSortKey(RENDER_PASS_UITransparent, 0, Instance->TextureIndex, Writer.SubmissionIndex + RunIndex);
+        }
+
+        Copied                 += Run;
+        Writer.SubmissionIndex += Run;
+        if((Writer.SubmissionIndex & RENDER_CHUNK_MASK) == 0)
+        {
+            Writer.Chunk = Writer.Chunk->Next;
+        }
     }
 }
 
@@ -499,30 +829,7 @@ DrawUIText(gl_render_data *RenderData,
            font_index      Font, 
            vec4            Color) 
 {
-    vec2 TextOrigin = Position;
-    real32 TrueScale = FontScale / 100.0f;
-    
-    for(uint32 StringIndex = 0;
-        StringIndex < Text.Length;
-        ++StringIndex)
-    {
-        if(Text.Data[StringIndex] == '\n')    
-        {
-            Position.Y += RenderData->LoadedFonts[Font].FontHeight * TrueScale;
-            Position.X = TextOrigin.X;
-            continue;
-        }
-        
-        char C = (Text.Data[StringIndex]);
-        font_glyph Glyph = RenderData->LoadedFonts[Font].Glyphs[C];
-        
-        vec2 RenderScale    = {Glyph.GlyphSize.X * TrueScale, (real32)Glyph.GlyphSize.Y * (TrueScale * 2)};
-        ivec2 AtlasOffset   = Glyph.GlyphUVs;
-        ivec2 GlyphSize     = Glyph.GlyphSize;
-        
-        DrawUIQuadTextured(RenderData, Position, RenderScale, AtlasOffset, GlyphSize, 0.0f, Color, 1, 1);
-        Position.X += Glyph.GlyphAdvance.X * TrueScale;
-    }
+    DrawUITextLayout(RenderData, GetTextLayout(RenderData, Text, FontScale, Font), Position, Color);
 }
 
 internal point_light*
@@ -533,6 +840,7 @@ CreatePointLight(gl_render_data   *RenderData,
                  attenuation_data *Attenuation,
                  vec4              Color)
 {   
+    Assert(RenderData->DrawFrame.PointLightCount < MAX_POINT_LIGHTS);
     point_light *Light    = &RenderData->DrawFrame.PointLights[RenderData->DrawFrame.PointLightCount++];
     
     mat4 Translation  = mat4Identity(1.0);
@@ -541,8 +849,9 @@ CreatePointLight(gl_render_data   *RenderData,
          Translation  = mat4Translation(Translation, v2Expand(Position, 0.0));
     vec3 TruePosition = Translation.Columns[3].XYZ;
     
+    // NOTE(Sleepster): The shader measures light distance in clip space, so the radius has to be scaled into it as well
     Light->Position    = TruePosition;
-    Light->Radius      = Radius;
+    Light->Radius      = Radius * fabsf(RenderData->GameCamera.ProjectionViewMatrix.Columns[0].X);
     Light->Strength    = Strength;
     Light->LightColor  = Color;
     Light->Attenuation = *Attenuation;
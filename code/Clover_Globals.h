@@ -35,14 +35,24 @@ constexpr vec4 DARK_GRAY = {0.05f, 0.05f, 0.05f, 1.0f};
 
 // RENDERER STUFF
 constexpr real32 SIMRATE = (1.0f/90.0f);
-constexpr uint32 MAX_QUADS    = 10000;
-constexpr uint32 MAX_VERTICES = MAX_QUADS * 4;
-constexpr uint32 MAX_INDICES  = MAX_QUADS * 6;
-constexpr uint32 TRUE_MAX_VERTICES = MAX_VERTICES * 2;
+
+// NOTE(Sleepster): Draws are queued into chunks from the frame arena so there's no per frame quad limit,
+//                  the upload ring starts at this many instances per region and doubles when a frame outgrows it
+constexpr uint32 RENDER_CHUNK_SHIFT              = 12;
+constexpr uint32 RENDER_CHUNK_QUADS              = 1 << RENDER_CHUNK_SHIFT;
+constexpr uint32 RENDER_CHUNK_MASK               = RENDER_CHUNK_QUADS - 1;
+constexpr uint32 DEFAULT_INSTANCE_RING_CAPACITY  = 16384;
+
+// NOTE(Sleepster): Each CloverRender flush writes into its own region of the instance ring
+constexpr uint32 UPLOAD_RING_REGIONS = 3;
 
 constexpr uint32 MAX_POINT_LIGHTS = 1000;
 constexpr uint32 MAX_SPOT_LIGHTS  = 1000;
 
+// NOTE(Sleepster): Starting sizes for the light tile buffers, both double when a frame needs more 
+constexpr uint32 DEFAULT_LIGHT_TILE_CAPACITY  = 4096;
+constexpr uint32 DEFAULT_LIGHT_INDEX_CAPACITY = 16384;
+
 
 // POST PROCESSING VALUES
 global_variable real32 RenderBrightness = 1.0f;
@@ -51,9 +61,16 @@ global_variable real32 RenderBrightness = 1.0f;
 // GAME GLOBALS
 constexpr uint32 MAX_SOUNDS      = 128;
 constexpr uint32 MAX_TRACKS      = 12;
-constexpr uint32 MAX_ENTITIES    = 10000;
 constexpr uint32 MAX_UI_ELEMENTS = 1000;
 
+// NOTE(Sleepster): Entities live in pages of 16k allocated from PermanentStorage as the world grows. 
+//                  The platform layer picks the max capacity at startup (-entities N), 64 pages is ~1M entities.
+constexpr uint32 ENTITY_PAGE_SHIFT       = 14;
+constexpr uint32 ENTITIES_PER_PAGE       = 1 << ENTITY_PAGE_SHIFT;
+constexpr uint32 ENTITY_PAGE_MASK        = ENTITIES_PER_PAGE - 1;
+constexpr uint32 MAX_ENTITY_PAGES        = 64;
+constexpr uint32 DEFAULT_ENTITY_CAPACITY = ENTITIES_PER_PAGE;
+
 constexpr real32 WORLD_SIZE   = 100;
 constexpr real32 TILE_SIZE    = 16;
 
@@ -75,7 +92,14 @@ constexpr uint32 MAX_CRAFTING_ELEMENTS = 9;
 constexpr uint32 MAX_ENTITY_DROPS      = 4;
 constexpr uint32 TOTAL_INVENTORY_SIZE = PLAYER_HOTBAR_COUNT + PLAYER_INVENTORY_SIZE;
 
-constexpr real32 PickupEpsilon = 5.0f;
+constexpr real32 ItemBobAmplitude = 1.0f;
+constexpr real32 ItemBobFrequency = 1.25f;
+
+// NOTE(Sleepster): In fixed update ticks (SIMRATE)
+constexpr uint32 ItemPickupDelayTicks = 45;
+
+// NOTE(Sleepster): Extra world units around an entity's bounds before it's culled, covers the bob and the selection box
+constexpr real32 EntityCullPadding = 16.0f;
 
 #define NULLSLOT 100
 
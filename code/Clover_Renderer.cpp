@@ -57,343 +57,1311 @@ glVerifyIVStatus(GLuint TestID, GLuint Type)
     }
 }
 
+// NOTE(Sleepster): Both atlas arrays are allocated up front with every page they'll ever have, loading a texture or font
+//                  just fills a layer. Nothing gets rebound between passes, a sprite's layer rides along in its instance.
 internal void
-CloverLoadFont(memory_arena *Memory, gl_render_data *RenderData, string Filepath, uint32 FontSize, font_index FontIndex)
+CloverCreateAtlasArrays(gl_render_data *RenderData)
 {
-    freetype_font_data Font = {};
-    Font.FontSize = FontSize;
-    FT_Error Error;
+    glGenTextures(1, &RenderData->SpriteAtlasArrayID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, RenderData->SpriteAtlasArrayID);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_SRGB8_ALPHA8, SPRITE_ATLAS_PAGE_SIZE, SPRITE_ATLAS_PAGE_SIZE, MAX_SPRITE_ATLAS_PAGES);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    Error = FT_Init_FreeType(&Font.FontFile);
+    glGenTextures(1, &RenderData->FontAtlasArrayID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, RenderData->FontAtlasArrayID);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, FONT_ATLAS_MIP_LEVELS, GL_R8, BITMAP_ATLAS_SIZE, BITMAP_ATLAS_SIZE, MAX_FONT_ATLAS_PAGES);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+internal inline uint64
+CloverHashBytes(uint64 Hash, void *Data, uint64 Size)
+{
+    uint8 *Bytes = (uint8 *)Data;
+    for(uint64 ByteIndex = 0;
+        ByteIndex < Size;
+        ++ByteIndex)
+    {
+        Hash ^= Bytes[ByteIndex];
+        Hash *= 0x100000001B3ull;
+    }
+    return(Hash);
+}
+
+internal inline uint32
+CloverHashGlyph(font_index Font, uint32 PixelSize, uint32 Codepoint)
+{
+    uint32 Hash = (Codepoint * 0x9E3779B1) ^ (PixelSize * 0x85EBCA77) ^ (uint32(Font) * 0xC2B2AE3D);
+    return(Hash ^ (Hash >> 16));
+}
+
+internal void
+CloverEvictGlyphPage(glyph_cache *Cache, uint32 PageIndex)
+{
+    for(uint32 BucketIndex = 0;
+        BucketIndex < GLYPH_CACHE_BUCKETS;
+        ++BucketIndex)
+    {
+        glyph_cache_entry **Link = &Cache->Buckets[BucketIndex];
+        while(*Link)
+        {
+            glyph_cache_entry *Entry = *Link;
+            if(Entry->Glyph.AtlasPage == PageIndex)
+            {
+                *Link                 = Entry->NextInBucket;
+                Entry->NextInBucket   = Cache->FirstFreeEntry;
+                Cache->FirstFreeEntry = Entry;
+                --Cache->CachedGlyphCount;
+            }
+            else
+            {
+                Link = &Entry->NextInBucket;
+            }
+        }
+    }
+
+    // NOTE(Sleepster): Cleared back to 0 so the padding around new glyphs reads as outside the SDF
+    glyph_atlas_page *Page = &Cache->AtlasPages[PageIndex];
+    memset(Cache->Pages + (uint64(PageIndex) * BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE), 0, uint64(BITMAP_ATLAS_SIZE) * BITMAP_ATLAS_SIZE);
+    Page->ShelfCount = 0;
+    Page->NextShelfY = GLYPH_ATLAS_PADDING;
+    Page->Dirty      = true;
+    Page->DirtyMin   = {0, 0};
+    Page->DirtyMax   = {BITMAP_ATLAS_SIZE, BITMAP_ATLAS_SIZE};
+    ++Cache->PagesEvicted;
+}
+
+internal int32
+CloverFindLeastRecentGlyphPage(glyph_cache *Cache)
+{
+    int32 Result = -1;
+    for(uint32 PageIndex = 0;
+        PageIndex < MAX_FONT_ATLAS_PAGES;
+        ++PageIndex)
+    {
+        glyph_atlas_page *Page = &Cache->AtlasPages[PageIndex];
+        if(Page->LastUsedFrame < Cache->Frame &&
+           (Result < 0 || Page->LastUsedFrame < Cache->AtlasPages[Result].LastUsedFrame))
+        {
+            Result = int32(PageIndex);
+        }
+    }
+    return(Result);
+}
+
+// NOTE(Sleepster): Best fit over the existing shelves, then a new shelf on the first page with room left
+internal bool8
+CloverPackGlyphInPage(glyph_atlas_page *Page, int32 Width, int32 Height, ivec2 *Slot)
+{
+    int32 PaddedWidth  = Width  + GLYPH_ATLAS_PADDING;
+    int32 PaddedHeight = Height + GLYPH_ATLAS_PADDING;
+
+    glyph_shelf *BestShelf = 0;
+    for(uint32 ShelfIndex = 0;
+        ShelfIndex < Page->ShelfCount;
+        ++ShelfIndex)
+    {
+        glyph_shelf *Shelf = &Page->Shelves[ShelfIndex];
+        if(Shelf->Height >= PaddedHeight && Shelf->NextX + PaddedWidth <= BITMAP_ATLAS_SIZE &&
+           (!BestShelf || Shelf->Height < BestShelf->Height))
+        {
+            BestShelf = Shelf;
+        }
+    }
+
+    if(!BestShelf)
+    {
+        int32 ShelfHeight = ((PaddedHeight + GLYPH_SHELF_ROUNDING - 1) / GLYPH_SHELF_ROUNDING) * GLYPH_SHELF_ROUNDING;
+        if(Page->ShelfCount == MAX_GLYPH_SHELVES || Page->NextShelfY + ShelfHeight > BITMAP_ATLAS_SIZE ||
+           GLYPH_ATLAS_PADDING + PaddedWidth > BITMAP_ATLAS_SIZE)
+        {
+            return(false);
+        }
+
+        BestShelf         = &Page->Shelves[Page->ShelfCount++];
+        BestShelf->Y      = Page->NextShelfY;
+        BestShelf->Height = ShelfHeight;
+        BestShelf->NextX  = GLYPH_ATLAS_PADDING;
+        Page->NextShelfY += ShelfHeight;
+    }
+
+    *Slot = {BestShelf->NextX, BestShelf->Y};
+    BestShelf->NextX += PaddedWidth;
+    return(true);
+}
+
+internal bool8
+CloverAllocateGlyphSlot(glyph_cache *Cache, int32 Width, int32 Height, uint32 *PageIndex, ivec2 *Slot)
+{
+    for(uint32 Index = 0;
+        Index < MAX_FONT_ATLAS_PAGES;
+        ++Index)
+    {
+        if(CloverPackGlyphInPage(&Cache->AtlasPages[Index], Width, Height, Slot))
+        {
+            *PageIndex = Index;
+            return(true);
+        }
+    }
+
+    int32 EvictedPage = CloverFindLeastRecentGlyphPage(Cache);
+    if(EvictedPage >= 0)
+    {
+        CloverEvictGlyphPage(Cache, uint32(EvictedPage));
+        if(CloverPackGlyphInPage(&Cache->AtlasPages[EvictedPage], Width, Height, Slot))
+        {
+            *PageIndex = uint32(EvictedPage);
+            return(true);
+        }
+    }
+    return(false);
+}
+
+internal glyph_cache_entry *
+CloverFindCachedGlyph(glyph_cache *Cache, font_index FontIndex, uint32 PixelSize, uint32 Codepoint)
+{
+    uint32 Bucket = CloverHashGlyph(FontIndex, PixelSize, Codepoint) & (GLYPH_CACHE_BUCKETS - 1);
+    for(glyph_cache_entry *Entry = Cache->Buckets[Bucket];
+        Entry;
+        Entry = Entry->NextInBucket)
+    {
+        if(Entry->Codepoint == Codepoint && Entry->PixelSize == PixelSize && Entry->Font == FontIndex)
+        {
+            if(Entry->Glyph.AtlasPage < MAX_FONT_ATLAS_PAGES)
+            {
+                Cache->AtlasPages[Entry->Glyph.AtlasPage].LastUsedFrame = Cache->Frame;
+            }
+            return(Entry);
+        }
+    }
+    return(0);
+}
+
+// NOTE(Sleepster): Packs an already rasterized SDF into a page and keeps it. Glyph only needs its metrics filled in,
+//                  the placement comes back in the result. If every page was drawn from this frame the glyph comes back
+//                  with its advance but no pixels and gets another try next time it's asked for.
+internal font_glyph
+CloverStoreGlyph(glyph_cache *Cache, font_index FontIndex, uint32 PixelSize, uint32 Codepoint, font_glyph Glyph, uint8 *Bitmap, int32 Pitch)
+{
+    // NOTE(Sleepster): Glyphs without pixels (spaces) are cached off page so evictions never touch them
+    Glyph.GlyphUVs  = {0, 0};
+    Glyph.AtlasPage = MAX_FONT_ATLAS_PAGES;
+
+    glyph_cache_entry *Entry = Cache->FirstFreeEntry;
+    if(!Entry)
+    {
+        int32 EvictedPage = CloverFindLeastRecentGlyphPage(Cache);
+        if(EvictedPage >= 0)
+        {
+            CloverEvictGlyphPage(Cache, uint32(EvictedPage));
+        }
+        Entry = Cache->FirstFreeEntry;
+    }
+    if(Entry)
+    {
+        Cache->FirstFreeEntry = Entry->NextInBucket;
+    }
+
+    if(Glyph.GlyphSize.X > 0 && Glyph.GlyphSize.Y > 0)
+    {
+        uint32 PageIndex;
+        ivec2  Slot;
+        if(!CloverAllocateGlyphSlot(Cache, Glyph.GlyphSize.X, Glyph.GlyphSize.Y, &PageIndex, &Slot))
+        {
+            if(Entry)
+            {
+                Entry->NextInBucket   = Cache->FirstFreeEntry;
+                Cache->FirstFreeEntry = Entry;
+            }
+            ++Cache->GlyphsDropped;
+            Glyph.GlyphSize = {0, 0};
+            return(Glyph);
+        }
+
+        uint8 *Page = Cache->Pages + (uint64(PageIndex) * BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE);
+        for(int32 YIndex = 0;
+            YIndex < Glyph.GlyphSize.Y;
+            ++YIndex)
+        {
+            memcpy(Page + ((Slot.Y + YIndex) * BITMAP_ATLAS_SIZE) + Slot.X, Bitmap + (YIndex * Pitch), Glyph.GlyphSize.X);
+        }
+
+        glyph_atlas_page *AtlasPage = &Cache->AtlasPages[PageIndex];
+        ivec2 SlotMax = {Slot.X + Glyph.GlyphSize.X, Slot.Y + Glyph.GlyphSize.Y};
+        if(AtlasPage->Dirty)
+        {
+            AtlasPage->DirtyMin = {MIN(AtlasPage->DirtyMin.X, Slot.X), MIN(AtlasPage->DirtyMin.Y, Slot.Y)};
+            AtlasPage->DirtyMax = {MAX(AtlasPage->DirtyMax.X, SlotMax.X), MAX(AtlasPage->DirtyMax.Y, SlotMax.Y)};
+        }
+        else
+        {
+            AtlasPage->Dirty    = true;
+            AtlasPage->DirtyMin = Slot;
+            AtlasPage->DirtyMax = SlotMax;
+        }
+        AtlasPage->LastUsedFrame = Cache->Frame;
+
+        Glyph.GlyphUVs  = Slot;
+        Glyph.AtlasPage = PageIndex;
+    }
+
+    // NOTE(Sleepster): Out of entries with every page in use this frame, the glyph still draws it just isn't kept
+    if(Entry)
+    {
+        uint32 Bucket = CloverHashGlyph(FontIndex, PixelSize, Codepoint) & (GLYPH_CACHE_BUCKETS - 1);
+        Entry->Font            = FontIndex;
+        Entry->PixelSize       = PixelSize;
+        Entry->Codepoint       = Codepoint;
+        Entry->Glyph           = Glyph;
+        Entry->NextInBucket    = Cache->Buckets[Bucket];
+        Cache->Buckets[Bucket] = Entry;
+        ++Cache->CachedGlyphCount;
+    }
+    return(Glyph);
+}
+
+// NOTE(Sleepster): Cached glyphs come straight back, anything else is rasterized here and stored into the CPU copy of
+//                  a page, CloverFlushGlyphCache uploads it before the frame renders
+internal font_glyph
+CloverGetGlyph(gl_render_data *RenderData, font_index FontIndex, uint32 PixelSize, uint32 Codepoint)
+{
+    glyph_cache       *Cache  = &RenderData->GlyphCache;
+    glyph_cache_entry *Cached = CloverFindCachedGlyph(Cache, FontIndex, PixelSize, Codepoint);
+    if(Cached) return(Cached->Glyph);
+
+    font_glyph Glyph = {};
+    font_data *Font  = &RenderData->LoadedFonts[FontIndex];
+    if(!Font->Face) return(Glyph);
+
+    if(Font->FacePixelSize != PixelSize)
+    {
+        FT_Set_Pixel_Sizes(Font->Face, 0, PixelSize);
+        Font->FacePixelSize = PixelSize;
+    }
+
+    FT_Error Error = FT_Load_Char(Font->Face, Codepoint, FT_LOAD_DEFAULT);
+    if(Error == 0)
+    {
+        Error = FT_Render_Glyph(Font->Face->glyph, FT_RENDER_MODE_SDF);
+    }
+    if(Error != 0)
+    {
+        // NOTE(Sleepster): Kept as an empty off page entry so a missing glyph costs FreeType (and the print) once
+        //                  instead of every frame it's on screen
+        printm("Failed to rasterize glyph U+%04X at %upx\n", Codepoint, PixelSize);
+        return(CloverStoreGlyph(Cache, FontIndex, PixelSize, Codepoint, Glyph, 0, 0));
+    }
+    ++Cache->GlyphsRasterized;
+
+    FT_GlyphSlot CurrentSlot = Font->Face->glyph;
+    Glyph.GlyphSize    = {int32(CurrentSlot->bitmap.width), int32(CurrentSlot->bitmap.rows)};
+    Glyph.GlyphAdvance = {real32(CurrentSlot->advance.x >> 6), real32(CurrentSlot->advance.y >> 6)};
+    Glyph.GlyphOffset  = {real32(CurrentSlot->bitmap_left), real32(CurrentSlot->bitmap_top)};
+
+    return(CloverStoreGlyph(Cache, FontIndex, PixelSize, Codepoint, Glyph, CurrentSlot->bitmap.buffer, CurrentSlot->bitmap.pitch));
+}
+
+// NOTE(Sleepster): glGenerateMipmap would rebuild every layer of the font array, so only the mips under a page's dirty
+//                  rect get remade. Each mip texel is box filtered straight from the page's base level.
+internal void
+CloverUploadGlyphPageMips(gl_render_data *RenderData, uint32 PageIndex, glyph_atlas_page *Page)
+{
+    uint8 *Base = RenderData->GlyphCache.Pages + (uint64(PageIndex) * BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    for(int32 Level = 1;
+        Level < FONT_ATLAS_MIP_LEVELS;
+        ++Level)
+    {
+        int32  BlockSize = 1 << Level;
+        uint32 BlockArea = uint32(BlockSize * BlockSize);
+        int32  MinX      = Page->DirtyMin.X >> Level;
+        int32  MinY      = Page->DirtyMin.Y >> Level;
+        int32  Width     = ((Page->DirtyMax.X + BlockSize - 1) >> Level) - MinX;
+        int32  Height    = ((Page->DirtyMax.Y + BlockSize - 1) >> Level) - MinY;
+
+        uint8 *Mip = (uint8 *)ArenaAlloc(RenderData->FrameArena, uint64(Width) * uint64(Height));
+        for(int32 Y = 0;
+            Y < Height;
+            ++Y)
+        {
+            for(int32 X = 0;
+                X < Width;
+                ++X)
+            {
+                uint8 *Block = Base + (uint64((MinY + Y) << Level) * BITMAP_ATLAS_SIZE) + ((MinX + X) << Level);
+                uint32 Sum   = 0;
+                for(int32 BlockY = 0;
+                    BlockY < BlockSize;
+                    ++BlockY)
+                {
+                    for(int32 BlockX = 0;
+                        BlockX < BlockSize;
+                        ++BlockX)
+                    {
+                        Sum += Block[(BlockY * BITMAP_ATLAS_SIZE) + BlockX];
+                    }
+                }
+                Mip[(Y * Width) + X] = uint8((Sum + (BlockArea / 2)) / BlockArea);
+            }
+        }
+
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, Level, 
+                        MinX, MinY, PageIndex,
+                        Width, Height, 1,
+                        GL_RED, GL_UNSIGNED_BYTE, Mip);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, BITMAP_ATLAS_SIZE);
+}
+
+// NOTE(Sleepster): Uploads whatever was rasterized this frame, called right before RenderData->CloverRender
+internal void
+CloverFlushGlyphCache(gl_render_data *RenderData)
+{
+    glyph_cache *Cache    = &RenderData->GlyphCache;
+    bool8        Uploaded = false;
+    for(uint32 PageIndex = 0;
+        PageIndex < MAX_FONT_ATLAS_PAGES;
+        ++PageIndex)
+    {
+        glyph_atlas_page *Page = &Cache->AtlasPages[PageIndex];
+        if(!Page->Dirty) continue;
+
+        Page->Dirty = false;
+        if(RenderData->Software.Enabled) continue;
+
+        if(!Uploaded)
+        {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, RenderData->FontAtlasArrayID);
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, BITMAP_ATLAS_SIZE);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            Uploaded = true;
+        }
+
+        uint8 *Source = Cache->Pages + (uint64(PageIndex) * BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE) + (Page->DirtyMin.Y * BITMAP_ATLAS_SIZE) + Page->DirtyMin.X;
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 
+                        Page->DirtyMin.X, Page->DirtyMin.Y, PageIndex,
+                        Page->DirtyMax.X - Page->DirtyMin.X, Page->DirtyMax.Y - Page->DirtyMin.Y, 1,
+                        GL_RED, GL_UNSIGNED_BYTE, Source);
+        CloverUploadGlyphPageMips(RenderData, PageIndex, Page);
+    }
+
+    if(Uploaded)
+    {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+    ++Cache->Frame;
+}
+
+internal void
+CloverInitGlyphCache(gl_render_data *RenderData)
+{
+    glyph_cache *Cache = &RenderData->GlyphCache;
+    FT_Error Error = FT_Init_FreeType(&Cache->Library);
     Check(Error == 0, "Failed to initialize Freetype\n");
-    
-    Error = FT_New_Face(Font.FontFile, (const char *)Filepath.Data, 0, &Font.FontFace);
-    Check(Error == 0, "Failed to initialize the Font Face\n");
+
+    uint64 PageBytes = uint64(BITMAP_ATLAS_SIZE) * BITMAP_ATLAS_SIZE;
+    Cache->Storage = ArenaCreate((sizeof(glyph_cache_entry) * MAX_CACHED_GLYPHS) + (PageBytes * MAX_FONT_ATLAS_PAGES) + Kilobytes(4));
+    Cache->Entries = (glyph_cache_entry *)ArenaAlloc(&Cache->Storage, sizeof(glyph_cache_entry) * MAX_CACHED_GLYPHS);
+    if(RenderData->Software.Enabled)
+    {
+        Cache->Pages = RenderData->Software.FontPages;
+    }
+    else
+    {
+        Cache->Pages = (uint8 *)ArenaAlloc(&Cache->Storage, PageBytes * MAX_FONT_ATLAS_PAGES);
+    }
+    Check(Cache->Entries && Cache->Pages, "Failed to allocate the glyph cache\n");
+    memset(Cache->Pages, 0, PageBytes * MAX_FONT_ATLAS_PAGES);
+
+    for(uint32 EntryIndex = 0;
+        EntryIndex < MAX_CACHED_GLYPHS;
+        ++EntryIndex)
+    {
+        Cache->Entries[EntryIndex].NextInBucket = (EntryIndex + 1 < MAX_CACHED_GLYPHS) ? &Cache->Entries[EntryIndex + 1] : 0;
+    }
+    Cache->FirstFreeEntry = &Cache->Entries[0];
+
+    for(uint32 PageIndex = 0;
+        PageIndex < MAX_FONT_ATLAS_PAGES;
+        ++PageIndex)
+    {
+        Cache->AtlasPages[PageIndex].NextShelfY = GLYPH_ATLAS_PADDING;
+    }
+    Cache->Frame = 1;
+
+    RenderData->CloverGetGlyph = CloverGetGlyph;
+}
+
+internal void
+CloverInitTextLayoutCache(gl_render_data *RenderData)
+{
+    text_layout_cache *Cache = &RenderData->TextLayouts;
+    Cache->Storage = ArenaCreate(TEXT_LAYOUT_STORAGE);
+    Cache->Layouts = (text_layout *)ArenaAlloc(&Cache->Storage, sizeof(text_layout) * MAX_TEXT_LAYOUTS);
+    Check(Cache->Layouts, "Failed to allocate the text layout cache\n");
+}
+
+internal bool8
+CloverReadFontBakeCache(font_bake *Bake)
+{
+    bool8 Result = false;
+
+    FILE *File = fopen(Bake->CachePath, "rb");
+    if(File)
+    {
+        font_bake_cache_header Header = {};
+        fread(&Header, sizeof(Header), 1, File);
+        if(Header.Magic       == FONT_BAKE_CACHE_MAGIC    &&
+           Header.Version     == FONT_BAKE_CACHE_VERSION  &&
+           Header.ContentHash == Bake->ContentHash        &&
+           Header.PixelSize   == Bake->PixelSize          &&
+           Header.GlyphCount  <= FONT_BAKE_GLYPH_COUNT    &&
+           Header.BitmapBytes <= FONT_BAKE_BITMAP_STORAGE)
+        {
+            Bake->GlyphCount  = Header.GlyphCount;
+            Bake->BitmapBytes = Header.BitmapBytes;
+
+            Result = fread(Bake->Glyphs, sizeof(font_bake_glyph), Header.GlyphCount, File) == Header.GlyphCount &&
+                     fread(Bake->Bitmaps, 1, Header.BitmapBytes, File) == Header.BitmapBytes;
+
+            // NOTE(Sleepster): Every glyph has to land inside the bitmaps that were read, anything else is a miss
+            for(uint32 GlyphIndex = 0;
+                Result && GlyphIndex < Bake->GlyphCount;
+                ++GlyphIndex)
+            {
+                font_bake_glyph *Glyph = &Bake->Glyphs[GlyphIndex];
+                Result = Glyph->GlyphSize.X >= 0 && Glyph->GlyphSize.Y >= 0 &&
+                         Glyph->GlyphSize.X <= BITMAP_ATLAS_SIZE && Glyph->GlyphSize.Y <= BITMAP_ATLAS_SIZE &&
+                         uint64(Glyph->BitmapOffset) + (uint64(Glyph->GlyphSize.X) * Glyph->GlyphSize.Y) <= Bake->BitmapBytes;
+            }
+        }
+        fclose(File);
+    }
+
+    return(Result);
+}
+
+internal void
+CloverWriteFontBakeCache(font_bake *Bake)
+{
+    CreateDirectoryA(FONT_BAKE_CACHE_DIRECTORY, 0);
+
+    // NOTE(Sleepster): Written beside the real path and moved over it, a bake killed halfway never leaves a torn cache
+    char TempPath[MAX_PATH + 8];
+    snprintf(TempPath, sizeof(TempPath), "%s.tmp", Bake->CachePath);
+
+    bool8 Written = false;
+    FILE *File    = fopen(TempPath, "wb");
+    if(File)
+    {
+        font_bake_cache_header Header = {};
+        Header.Magic       = FONT_BAKE_CACHE_MAGIC;
+        Header.Version     = FONT_BAKE_CACHE_VERSION;
+        Header.ContentHash = Bake->ContentHash;
+        Header.PixelSize   = Bake->PixelSize;
+        Header.GlyphCount  = Bake->GlyphCount;
+        Header.BitmapBytes = Bake->BitmapBytes;
+
+        Written = fwrite(&Header, sizeof(Header), 1, File) == 1 &&
+                  fwrite(Bake->Glyphs, sizeof(font_bake_glyph), Bake->GlyphCount, File) == Bake->GlyphCount &&
+                  fwrite(Bake->Bitmaps, 1, Bake->BitmapBytes, File) == Bake->BitmapBytes;
+        Written = (fclose(File) == 0) && Written;
+    }
+
+    if(!Written || !MoveFileExA(TempPath, Bake->CachePath, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileA(TempPath);
+        Trace("Failed to write the font bake cache, it'll be baked again next launch\n");
+    }
+}
+
+// NOTE(Sleepster): Runs on a worker with its own Freetype library and face, neither can be shared with the main thread's
+internal WORK_QUEUE_CALLBACK(CloverBakeFontWork)
+{
+    font_bake *Bake = (font_bake *)Data;
+
+    FT_Library Library;
+    FT_Face    Face;
+    FT_Error   Error = FT_Init_FreeType(&Library);
+    if(Error == 0)
+    {
+        Error = FT_New_Memory_Face(Library, Bake->FontFile, FT_Long(Bake->FontFileSize), 0, &Face);
+        if(Error == 0)
+        {
+            FT_Set_Pixel_Sizes(Face, 0, Bake->PixelSize);
+
+            Bake->GlyphCount  = 0;
+            Bake->BitmapBytes = 0;
+            for(uint32 Codepoint = FONT_BAKE_FIRST_CODEPOINT;
+                Codepoint < FONT_BAKE_FIRST_CODEPOINT + FONT_BAKE_GLYPH_COUNT;
+                ++Codepoint)
+            {
+                if(FT_Load_Char(Face, Codepoint, FT_LOAD_DEFAULT) != 0 || FT_Render_Glyph(Face->glyph, FT_RENDER_MODE_SDF) != 0)
+                {
+                    continue;
+                }
+
+                FT_GlyphSlot     CurrentSlot = Face->glyph;
+                font_bake_glyph *Glyph       = &Bake->Glyphs[Bake->GlyphCount];
+                Glyph->Codepoint    = Codepoint;
+                Glyph->BitmapOffset = Bake->BitmapBytes;
+                Glyph->GlyphSize    = {int32(CurrentSlot->bitmap.width), int32(CurrentSlot->bitmap.rows)};
+                Glyph->GlyphAdvance = {real32(CurrentSlot->advance.x >> 6), real32(CurrentSlot->advance.y >> 6)};
+                Glyph->GlyphOffset  = {real32(CurrentSlot->bitmap_left), real32(CurrentSlot->bitmap_top)};
+
+                uint32 GlyphBytes = uint32(Glyph->GlyphSize.X * Glyph->GlyphSize.Y);
+                if(Bake->BitmapBytes + GlyphBytes > FONT_BAKE_BITMAP_STORAGE) break;
+
+                for(int32 YIndex = 0;
+                    YIndex < Glyph->GlyphSize.Y;
+                    ++YIndex)
+                {
+                    memcpy(Bake->Bitmaps + Bake->BitmapBytes + (YIndex * Glyph->GlyphSize.X),
+                           CurrentSlot->bitmap.buffer + (YIndex * CurrentSlot->bitmap.pitch),
+                           Glyph->GlyphSize.X);
+                }
+                Bake->BitmapBytes += GlyphBytes;
+                ++Bake->GlyphCount;
+            }
+            FT_Done_Face(Face);
+
+            CloverWriteFontBakeCache(Bake);
+        }
+        FT_Done_FreeType(Library);
+    }
+
+    InterlockedExchange((volatile LONG *)&Bake->State, FONT_BAKE_READY);
+}
+
+// NOTE(Sleepster): Anything the game already rasterized itself while the bake was running is left alone
+internal void
+CloverInstallFontBake(gl_render_data *RenderData, font_bake *Bake)
+{
+    glyph_cache *Cache = &RenderData->GlyphCache;
+    for(uint32 GlyphIndex = 0;
+        GlyphIndex < Bake->GlyphCount;
+        ++GlyphIndex)
+    {
+        font_bake_glyph *Baked = &Bake->Glyphs[GlyphIndex];
+        if(CloverFindCachedGlyph(Cache, Bake->Font, Bake->PixelSize, Baked->Codepoint)) continue;
+
+        font_glyph Glyph = {};
+        Glyph.GlyphSize    = Baked->GlyphSize;
+        Glyph.GlyphAdvance = Baked->GlyphAdvance;
+        Glyph.GlyphOffset  = Baked->GlyphOffset;
+        CloverStoreGlyph(Cache, Bake->Font, Bake->PixelSize, Baked->Codepoint, Glyph, Bake->Bitmaps + Baked->BitmapOffset, Baked->GlyphSize.X);
+    }
+}
+
+// NOTE(Sleepster): Called once a frame, picks up bakes the workers finished
+internal void
+CloverProcessFontBakes(gl_render_data *RenderData)
+{
+    for(uint32 FontIndex = 0;
+        FontIndex < FONT_COUNT;
+        ++FontIndex)
+    {
+        font_bake *Bake = &RenderData->GlyphCache.Bakes[FontIndex];
+        if(Bake->State == FONT_BAKE_READY)
+        {
+            CloverInstallFontBake(RenderData, Bake);
+            Bake->State = FONT_BAKE_IDLE;
+        }
+    }
+}
+
+// NOTE(Sleepster): Opens the face for the glyph cache out of memory, the same bytes key the bake cache. Printable ASCII
+//                  at the base size is nearly all the text there is, a warm start reads it straight from the cache and a
+//                  cold one bakes it on the work queue while the glyph cache covers anything drawn in the meantime.
+// TODO(Sleepster): Revisit this to fix the alignment issues with letters like "p" "g" "l" "y" and such
+internal void
+CloverLoadSDFFont(gl_render_data *RenderData, string Filepath, uint32 FontSize, font_index FontName)
+{
+    glyph_cache *Cache = &RenderData->GlyphCache;
+    font_data   *Font  = &RenderData->LoadedFonts[FontName];
+    font_bake   *Bake  = &Cache->Bakes[FontName];
+
+    int32 FileSize = GetFileSizeInBytes(Filepath);
+    Check(FileSize > 0, "Failed to find the font file\n");
+
+    uint32 FontFileSize = 0;
+    Bake->Arena        = ArenaCreate(uint64(FileSize) + FONT_BAKE_STORAGE);
+    Bake->FontFile     = ReadEntireFileMA(&Bake->Arena, Filepath, &FontFileSize).Data;
+    Bake->FontFileSize = FontFileSize;
+    Bake->Font         = FontName;
+    Bake->PixelSize    = FontSize;
+
+    // NOTE(Sleepster): Allocated once up front, a cache miss and the bake after it both write into the same space
+    Bake->Glyphs       = (font_bake_glyph *)ArenaAlloc(&Bake->Arena, sizeof(font_bake_glyph) * FONT_BAKE_GLYPH_COUNT);
+    Bake->Bitmaps      = (uint8 *)ArenaAlloc(&Bake->Arena, FONT_BAKE_BITMAP_STORAGE);
+
+    FT_Error Error = FT_New_Memory_Face(Cache->Library, Bake->FontFile, FT_Long(Bake->FontFileSize), 0, &Font->Face);
     Check(Error != FT_Err_Unknown_File_Format, "Failed to load the font file, it is found but not supported\n");
-    
-    // NOTE(Sleepster): Test, we would normally use FT_Set_Pixel_Sizes(); 
-    Error = FT_Set_Pixel_Sizes(Font.FontFace, 0, Font.FontSize);
+    Check(Error == 0, "Failed to initialize the Font Face\n");
+
+    Error = FT_Set_Pixel_Sizes(Font->Face, 0, FontSize);
     Check(Error == 0, "Issue setting the pixel size of the font\n");
+
+    Font->FacePixelSize = FontSize;
+    Font->FontSize      = FontSize;
+    Font->FontHeight    = uint32((Font->Face->size->metrics.ascender - Font->Face->size->metrics.descender) >> 6);
+
+    uint32 Layout[4]  = {FONT_BAKE_CACHE_VERSION, FontSize, FONT_BAKE_FIRST_CODEPOINT, FONT_BAKE_GLYPH_COUNT};
+    Bake->ContentHash = CloverHashBytes(CloverHashBytes(0xCBF29CE484222325ull, Bake->FontFile, Bake->FontFileSize), Layout, sizeof(Layout));
+    snprintf(Bake->CachePath, sizeof(Bake->CachePath), "%s/Font%016llX.cache", FONT_BAKE_CACHE_DIRECTORY, Bake->ContentHash);
+
+    if(CloverReadFontBakeCache(Bake))
+    {
+        CloverInstallFontBake(RenderData, Bake);
+        CloverFlushGlyphCache(RenderData);
+    }
+    else
+    {
+        Bake->State = FONT_BAKE_RUNNING;
+        Win32AddWorkEntry(RenderData->WorkQueue, CloverBakeFontWork, Bake);
+    }
+}
+
+internal GLuint
+CloverCompileShaderSource(uint32 ShaderType, string ShaderSource)
+{
+    GLuint SourceID = glCreateShader(ShaderType);
+
+    const char *ShaderSourceChar = (const char *)ShaderSource.Data;
+    GLint       SourceLength     = GLint(ShaderSource.Length);
+    glShaderSource(SourceID, 1, &ShaderSourceChar, &SourceLength);
+    glCompileShader(SourceID);
+    glVerifyIVStatus(SourceID, GL_VERTEX_SHADER);
+
+    return(SourceID);
+}
+
+// NOTE(Sleepster): The environment hash covers the driver strings and the common include, anything in it changing
+//                  invalidates every cached binary. Has to be redone whenever CommonShader.glh gets registered again.
+internal void
+CloverRegisterCommonShader(memory_arena *Scratch, gl_render_data *RenderData)
+{
+    uint32 Size = {};
+    string CommonGLHeader = ReadEntireFileMA(Scratch, COMMON_SHADER_PATH, &Size);
+    glNamedStringARB(GL_SHADER_INCLUDE_ARB, -1, COMMON_SHADER_INCLUDE_NAME, int32(CommonGLHeader.Length), CSTR(CommonGLHeader));
+    RenderData->CommonShaderLastWriteTime = Win32GetLastWriteTime(COMMON_SHADER_PATH);
+
+    const char *Vendor   = (const char *)glGetString(GL_VENDOR);
+    const char *Renderer = (const char *)glGetString(GL_RENDERER);
+    const char *Version  = (const char *)glGetString(GL_VERSION);
+
+    uint64 Hash = 0xCBF29CE484222325ull;
+    Hash = CloverHashBytes(Hash, (void *)Vendor,   strlen(Vendor));
+    Hash = CloverHashBytes(Hash, (void *)Renderer, strlen(Renderer));
+    Hash = CloverHashBytes(Hash, (void *)Version,  strlen(Version));
+    Hash = CloverHashBytes(Hash, CommonGLHeader.Data, CommonGLHeader.Length);
+    RenderData->ShaderEnvironmentHash = Hash;
+}
+
+// NOTE(Sleepster): Binaries are named after the vertex shader, "../code/shader/Basic.vert" caches to SHADER_CACHE_DIRECTORY/Basic.program
+internal void
+CloverShaderCachePath(string VertexShader, char *CachePath)
+{
+    const char *Name      = CSTR(VertexShader);
+    const char *LastSlash = strrchr(Name, '/');
+    Name = LastSlash ? LastSlash + 1 : Name;
+
+    uint32 NameLength = 0;
+    while(Name[NameLength] && Name[NameLength] != '.')
+    {
+        ++NameLength;
+    }
+    snprintf(CachePath, MAX_PATH, "%s/%.*s.program", CSTR(SHADER_CACHE_DIRECTORY), int32(NameLength), Name);
+}
+
+// NOTE(Sleepster): glProgramBinary raises GL_INVALID_ENUM on a format the driver doesn't list, which the debug callback
+//                  would turn into an assert instead of a cache miss
+internal bool8
+CloverProgramBinaryFormatSupported(memory_arena *Scratch, GLenum BinaryFormat)
+{
+    bool8 Result = false;
+
+    GLint FormatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &FormatCount);
+    if(FormatCount > 0)
+    {
+        GLint *Formats = (GLint *)ArenaAlloc(Scratch, sizeof(GLint) * uint64(FormatCount));
+        glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, Formats);
+        for(GLint FormatIndex = 0;
+            FormatIndex < FormatCount;
+            ++FormatIndex)
+        {
+            if(GLenum(Formats[FormatIndex]) == BinaryFormat)
+            {
+                Result = true;
+                break;
+            }
+        }
+    }
+
+    return(Result);
+}
+
+internal bool8
+CloverLoadProgramBinary(memory_arena *Scratch, GLuint ProgramID, const char *CachePath, uint64 ContentHash)
+{
+    bool8 Result = false;
+
+    FILE *File = fopen(CachePath, "rb");
+    if(File)
+    {
+        fseek(File, 0, SEEK_END);
+        uint64 FileSize = uint64(ftell(File));
+        fseek(File, 0, SEEK_SET);
+
+        // NOTE(Sleepster): The binary has to be exactly the rest of the file and fit in what's left of the scratch
+        //                  arena (plus up to 8 bytes of alignment), otherwise a truncated cache file is just a miss.
+        //                  The format list is queried first since it allocates from the same arena.
+        shader_cache_header Header = {};
+        if(fread(&Header, sizeof(Header), 1, File) == 1 &&
+           Header.Magic       == SHADER_CACHE_MAGIC     &&
+           Header.Version     == SHADER_CACHE_VERSION   &&
+           Header.ContentHash == ContentHash            &&
+           CloverProgramBinaryFormatSupported(Scratch, Header.BinaryFormat) &&
+           Header.BinaryLength > 0                                          &&
+           sizeof(Header) + uint64(Header.BinaryLength) == FileSize         &&
+           uint64(Header.BinaryLength) + 8 <= Scratch->Capacity - Scratch->Used)
+        {
+            void *Binary = ArenaAlloc(Scratch, Header.BinaryLength);
+            if(fread(Binary, Header.BinaryLength, 1, File) == 1)
+            {
+                glProgramBinary(ProgramID, Header.BinaryFormat, Binary, GLsizei(Header.BinaryLength));
+
+                // NOTE(Sleepster): A driver update can reject a binary even with the same version string, that's just a miss
+                GLint LinkStatus = GL_FALSE;
+                glGetProgramiv(ProgramID, GL_LINK_STATUS, &LinkStatus);
+                Result = LinkStatus == GL_TRUE;
+            }
+        }
+        fclose(File);
+    }
+
+    return(Result);
+}
+
+internal void
+CloverSaveProgramBinary(memory_arena *Scratch, GLuint ProgramID, const char *CachePath, uint64 ContentHash)
+{
+    GLint BinaryLength = 0;
+    glGetProgramiv(ProgramID, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if(BinaryLength <= 0) return;
+
+    shader_cache_header Header = {};
+    Header.Magic        = SHADER_CACHE_MAGIC;
+    Header.Version      = SHADER_CACHE_VERSION;
+    Header.ContentHash  = ContentHash;
+
+    void *Binary = ArenaAlloc(Scratch, uint64(BinaryLength));
+    GLsizei WrittenLength = 0;
+    glGetProgramBinary(ProgramID, BinaryLength, &WrittenLength, &Header.BinaryFormat, Binary);
+    Header.BinaryLength = uint32(WrittenLength);
+
+    CreateDirectoryA("../data/cache", 0);
+    CreateDirectoryA(CSTR(SHADER_CACHE_DIRECTORY), 0);
+
+    FILE *File = fopen(CachePath, "wb");
+    if(File)
+    {
+        fwrite(&Header, sizeof(Header), 1, File);
+        fwrite(Binary, Header.BinaryLength, 1, File);
+        fclose(File);
+    }
+    else
+    {
+        Trace("Failed to write a shader binary, it'll be compiled again next launch\n");
+    }
+}
+
+// NOTE(Sleepster): Tries the cached program binary first and only compiles from source when it's missing or stale
+internal shader
+CloverCreateShader(memory_arena *Memory, gl_render_data *RenderData, string VertexShader, string FragmentShader)
+{
+    glUseProgram(0);
+    shader ReturnShader = {};
     
-    Font.AtlasPadding = 4;
-    int32 Row = {};
-    int32 Column = Font.AtlasPadding;
+    ReturnShader.VertexShader.Filepath        = VertexShader;
+    ReturnShader.FragmentShader.Filepath      = FragmentShader;
+    ReturnShader.VertexShader.LastWriteTime   = Win32GetLastWriteTime(VertexShader);
+    ReturnShader.FragmentShader.LastWriteTime = Win32GetLastWriteTime(FragmentShader);
+
+    uint32 FileSize = 0;
+    string VertexSource   = ReadEntireFileMA(Memory, VertexShader,   &FileSize);
+    string FragmentSource = ReadEntireFileMA(Memory, FragmentShader, &FileSize);
+    Check(VertexSource.Data && FragmentSource.Data, "Shader file is either not found or does not contain strings!\n");
+
+    uint64 ContentHash = RenderData->ShaderEnvironmentHash;
+    ContentHash = CloverHashBytes(ContentHash, VertexSource.Data,   VertexSource.Length);
+    ContentHash = CloverHashBytes(ContentHash, FragmentSource.Data, FragmentSource.Length);
+
+    char CachePath[MAX_PATH] = {};
+    CloverShaderCachePath(VertexShader, CachePath);
+
+    ReturnShader.ShaderID = glCreateProgram();
+    if(!CloverLoadProgramBinary(Memory, ReturnShader.ShaderID, CachePath, ContentHash))
+    {
+        ReturnShader.VertexShader.SourceID   = CloverCompileShaderSource(GL_VERTEX_SHADER,   VertexSource);
+        ReturnShader.FragmentShader.SourceID = CloverCompileShaderSource(GL_FRAGMENT_SHADER, FragmentSource);
+
+        glAttachShader(ReturnShader.ShaderID, ReturnShader.VertexShader.SourceID);
+        glAttachShader(ReturnShader.ShaderID, ReturnShader.FragmentShader.SourceID);
+        glProgramParameteri(ReturnShader.ShaderID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(ReturnShader.ShaderID);
+        
+        glVerifyIVStatus(ReturnShader.ShaderID, GL_PROGRAM);
+        
+        glDetachShader(ReturnShader.ShaderID, ReturnShader.VertexShader.SourceID);
+        glDetachShader(ReturnShader.ShaderID, ReturnShader.FragmentShader.SourceID);
+        glDeleteShader(ReturnShader.VertexShader.SourceID);
+        glDeleteShader(ReturnShader.FragmentShader.SourceID);
+        ReturnShader.VertexShader.SourceID   = 0;
+        ReturnShader.FragmentShader.SourceID = 0;
+
+        CloverSaveProgramBinary(Memory, ReturnShader.ShaderID, CachePath, ContentHash);
+    }
     
-    char *TextureData = ArenaAlloc(Memory, (uint64)(sizeof(char) * (BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE)));
-    if(TextureData)
+    return(ReturnShader);
+}
+
+// NOTE(Sleepster): Non blocking, returns true if the fence is gone or has signaled and clears it
+internal bool8
+CloverStagingFenceSignaled(GLsync *Fence)
+{
+    bool8 Result = true;
+    if(*Fence)
+    {
+        GLenum WaitResult = glClientWaitSync(*Fence, 0, 0);
+        Result = (WaitResult == GL_ALREADY_SIGNALED || WaitResult == GL_CONDITION_SATISFIED);
+        if(Result)
+        {
+            glDeleteSync(*Fence);
+            *Fence = 0;
+        }
+    }
+    return(Result);
+}
+
+internal void
+CloverCreateTextureStaging(gl_render_data *RenderData)
+{
+    GLsizeiptr StagingSize  = GLsizeiptr(TEXTURE_STAGING_REGION_SIZE * TEXTURE_STAGING_REGIONS);
+    GLbitfield StagingFlags = GL_MAP_WRITE_BIT|GL_MAP_PERSISTENT_BIT|GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &RenderData->TextureStagingBufferID);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, RenderData->TextureStagingBufferID);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, StagingSize, 0, StagingFlags);
+    RenderData->TextureStaging = (uint8 *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, StagingSize, StagingFlags);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    Check(RenderData->TextureStaging, "Failed to map the texture staging buffer\n");
+
+    // NOTE(Sleepster): Page 0 starts out as the placeholder, untextured quads and sprites that haven't
+    //                  arrived yet sample it until the sprite atlas build lands
+    uint32 Placeholder = 0xFFFFFFFF;
+    glClearTexSubImage(RenderData->SpriteAtlasArrayID, 0, 0, 0, 0, SPRITE_ATLAS_PAGE_SIZE, SPRITE_ATLAS_PAGE_SIZE, 1,
+                       GL_RGBA, GL_UNSIGNED_BYTE, &Placeholder);
+}
+
+// NOTE(Sleepster): The region we're moving onto was last drawn from UPLOAD_RING_REGIONS flushes ago,
+//                  wait on its fence before letting anything write over it.
+internal void
+CloverAcquireUploadRegion(gl_render_data *RenderData)
+{
+    uint32 Region = RenderData->DrawFrame.UploadRegion;
+    GLsync Fence  = RenderData->DrawFrame.UploadFences[Region];
+    if(Fence)
     {
-        for(uint32 GlyphIndex = 32;
-            GlyphIndex < 127;
-            ++GlyphIndex)
+        GLenum WaitResult = GL_TIMEOUT_EXPIRED;
+        while(WaitResult == GL_TIMEOUT_EXPIRED)
         {
-            if(Column + Font.FontFace->glyph->bitmap.width + Font.AtlasPadding >= BITMAP_ATLAS_SIZE)
-            {
-                Column = Font.AtlasPadding;
-                // NOTE(Sleepster): This is a product of our "test". Freetype uses >> 6 on sizes, so we divide by 3 to offset it 
-                //                  ONLY WHEN USING FT_Set_Char_Size
-                Row += Font.FontSize;
-            }
-            // NOTE(Sleepster): Leaving this here would make it only work for one font, perhaps make it so we pass in a font index into an array of 
-            //                  fonts? Simply have a cap for the amount of fonts that can be loaded at any one point.
-            RenderData->LoadedFonts[FontIndex].FontHeight = MAX((Font.FontFace->size->metrics.ascender - Font.FontFace->size->metrics.descender) >> 6,
-                                                                (int32)RenderData->LoadedFonts[FontIndex].FontHeight);
-            for(uint32 YIndex = 0;
-                YIndex < Font.FontFace->glyph->bitmap.rows;
-                ++YIndex)
-            {
-                for(uint32 XIndex = 0;
-                    XIndex < Font.FontFace->glyph->bitmap.width;
-                    ++XIndex)
-                {
-                    TextureData[(Row + YIndex) * BITMAP_ATLAS_SIZE + (Column + XIndex)] = 
-                        Font.FontFace->glyph->bitmap.buffer[YIndex * Font.FontFace->glyph->bitmap.width + XIndex];
-                }
-            }
-            font_glyph *CurrentGlyph = &RenderData->LoadedFonts[FontIndex].Glyphs[GlyphIndex];
-            CurrentGlyph->GlyphUVs  = {Column, Row};
-            CurrentGlyph->GlyphSize = 
-            {
-                (int32)Font.FontFace->glyph->bitmap.width, 
-                (int32)Font.FontFace->glyph->bitmap.rows
-            };
-            CurrentGlyph->GlyphAdvance = 
-            {
-                real32(Font.FontFace->glyph->advance.x >> 6), 
-                real32(Font.FontFace->glyph->advance.y >> 6)
-            };
-            CurrentGlyph->GlyphOffset = 
-            {
-                real32(Font.FontFace->glyph->bitmap_left),
-                real32(Font.FontFace->glyph->bitmap_top)
-            };
-            
-            Column += Font.FontFace->glyph->bitmap.width + Font.AtlasPadding;
+            WaitResult = glClientWaitSync(Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
         }
+        Assert(WaitResult != GL_WAIT_FAILED);
         
-        FT_Done_Face(Font.FontFace);
-        FT_Done_FreeType(Font.FontFile);
-        
-        // OPENGL TEXTURE
-        {
-            glActiveTexture(GL_TEXTURE0 + RenderData->TextureCount);
-            ++RenderData->TextureCount;
-            
-            glGenTextures(1, &RenderData->LoadedFonts[FontIndex].FontAtlas.TextureID);
-            glBindTexture(GL_TEXTURE_2D, RenderData->LoadedFonts[FontIndex].FontAtlas.TextureID);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, BITMAP_ATLAS_SIZE, BITMAP_ATLAS_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, TextureData);
-            
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-           glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glBindTexture(GL_TEXTURE_2D, 0);
-        }
-    }
-    else
-    {
-        Check(0, "Failed to Allocate Storage\n");
+        glDeleteSync(Fence);
+        RenderData->DrawFrame.UploadFences[Region] = 0;
     }
 }
 
-// TODO(Sleepster): Revisit this to fix the alignment issues with letters like "p" "g" "l" "y" and such
 internal void
-CloverLoadSDFFont(memory_arena *Memory, gl_render_data *RenderData, string Filepath, uint32 FontSize, font_index FontName)
+CloverResetRendererState(gl_render_data *RenderData)
 {
-    freetype_font_data Font = {};
-    Font.FontSize = FontSize;
-    FT_Error Error;
-    
-    Error = FT_Init_FreeType(&Font.FontFile);
-    Check(Error == 0, "Failed to initialize Freetype\n");
-    
-    Error = FT_New_Face(Font.FontFile, (const char *)Filepath.Data, 0, &Font.FontFace);
-    Check(Error == 0, "Failed to initialize the Font Face\n");
-    Check(Error != FT_Err_Unknown_File_Format, "Failed to load the font file, it is found but not supported\n");
-    
-    // NOTE(Sleepster): Test, we would normally use FT_Set_Pixel_Sizes(); 
-    Error = FT_Set_Pixel_Sizes(Font.FontFace, 0, Font.FontSize);
-    Check(Error == 0, "Issue setting the pixel size of the font\n");
-    
-    Font.AtlasPadding = 8;
-    int32 Row = {};
-    int32 Column = Font.AtlasPadding;
-    
-    FT_GlyphSlot CurrentSlot = Font.FontFace->glyph;
-    
-    char *TextureData = ArenaAlloc(Memory, (uint64)(sizeof(char) * (BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE)));
-    if(TextureData)
+    RenderData->DrawFrame.FirstChunk      = 0;
+    RenderData->DrawFrame.CurrentChunk    = 0;
+    RenderData->DrawFrame.ChunkCount      = 0;
+    RenderData->DrawFrame.QueuedQuadCount = 0;
+
+    RenderData->DrawFrame.PointLightCount = 0;
+    RenderData->DrawFrame.SpotLightCount = 0;
+}
+
+internal void
+CloverBeginRenderTimer(gl_render_data *RenderData, render_timer Timer)
+{
+    render_timers *Timers = &RenderData->Timers;
+    LARGE_INTEGER Counter;
+    QueryPerformanceCounter(&Counter);
+    Timers->CPUStart[Timer] = Counter.QuadPart;
+
+    glBeginQuery(GL_TIME_ELAPSED, Timers->Queries[Timers->QuerySet][Timer]);
+}
+
+internal void
+CloverEndRenderTimer(gl_render_data *RenderData, render_timer Timer)
+{
+    render_timers *Timers = &RenderData->Timers;
+    glEndQuery(GL_TIME_ELAPSED);
+
+    LARGE_INTEGER Counter;
+    QueryPerformanceCounter(&Counter);
+    Timers->CPUMilliseconds[Timer][Timers->HistoryIndex] = 
+        real32(real64(Counter.QuadPart - Timers->CPUStart[Timer]) * 1000.0 / real64(PerfCountFrequency));
+}
+
+// NOTE(Sleepster): Called before this frame's timers are begun, reads back what the set we're about to reuse measured
+internal void
+CloverCollectRenderTimers(gl_render_data *RenderData)
+{
+    render_timers *Timers = &RenderData->Timers;
+    uint32 QuerySet = Timers->QuerySet;
+    if(Timers->Issued[QuerySet])
     {
-        for(uint32 GlyphIndex = 32;
-            GlyphIndex < 127;
-            ++GlyphIndex)
+        GLuint Available = GL_FALSE;
+        glGetQueryObjectuiv(Timers->Queries[QuerySet][RENDER_TIMER_Count - 1], GL_QUERY_RESULT_AVAILABLE, &Available);
+        for(uint32 Timer = 0;
+            Timer < RENDER_TIMER_Count;
+            ++Timer)
         {
-            FT_Load_Char(Font.FontFace, GlyphIndex, FT_LOAD_DEFAULT);
-            if(Column + Font.FontFace->glyph->bitmap.width + Font.AtlasPadding >= BITMAP_ATLAS_SIZE)
+            real32 Milliseconds = 0.0f;
+            if(Available)
             {
-                Column = Font.AtlasPadding;
-                Row += int32(Font.FontSize * 1.20);
+                GLuint64 Nanoseconds = 0;
+                glGetQueryObjectui64v(Timers->Queries[QuerySet][Timer], GL_QUERY_RESULT, &Nanoseconds);
+                Milliseconds = real32(real64(Nanoseconds) / 1000000.0);
             }
-            
-            Error = FT_Render_Glyph(CurrentSlot, FT_RENDER_MODE_SDF);
-            Check(Error == 0, "Issues here\n");
-            
-            RenderData->LoadedFonts[FontName].FontHeight   = MAX((Font.FontFace->size->metrics.ascender - Font.FontFace->size->metrics.descender) >> 6,
-                                                                 (int32)RenderData->LoadedFonts[GlyphIndex].FontHeight);
-            for(uint32 YIndex = 0;
-                YIndex < Font.FontFace->glyph->bitmap.rows;
-                ++YIndex)
+            else
             {
-                for(uint32 XIndex = 0;
-                    XIndex < Font.FontFace->glyph->bitmap.width;
-                    ++XIndex)
-                {
-                    TextureData[(Row + YIndex) * BITMAP_ATLAS_SIZE + (Column + XIndex)] = 
-                        Font.FontFace->glyph->bitmap.buffer[YIndex * Font.FontFace->glyph->bitmap.width + XIndex];
-                }
+                uint32 LastIndex = (Timers->HistoryIndex + RENDER_TIMER_HISTORY - 1) % RENDER_TIMER_HISTORY;
+                Milliseconds = Timers->GPUMilliseconds[Timer][LastIndex];
             }
-            
-            font_glyph *CurrentGlyph = &RenderData->LoadedFonts[0].Glyphs[GlyphIndex];
-            CurrentGlyph->GlyphUVs  = {Column, Row};
-            CurrentGlyph->GlyphSize = 
-            {
-                (int32)Font.FontFace->glyph->bitmap.width, 
-                (int32)Font.FontFace->glyph->bitmap.rows
-            };
-            CurrentGlyph->GlyphAdvance = 
-            {
-                real32(Font.FontFace->glyph->advance.x >> 6), 
-                real32(Font.FontFace->glyph->advance.y >> 6)
-            };
-            CurrentGlyph->GlyphOffset = 
-            {
-                real32(Font.FontFace->glyph->bitmap_left),
-                real32(Font.FontFace->glyph->bitmap_top)
-            };
-            
-            Column += Font.FontFace->glyph->bitmap.width + Font.AtlasPadding;
+            Timers->GPUMilliseconds[Timer][Timers->HistoryIndex] = Milliseconds;
         }
     }
-    
-    FT_Done_Face(Font.FontFace);
-    FT_Done_FreeType(Font.FontFile);
-    
-    // SDF TEXTURE DATA
-    {
-        glActiveTexture(GL_TEXTURE0 + RenderData->TextureCount);
-        glGenTextures(1, &RenderData->LoadedFonts[0].FontAtlas.TextureID);
-        glBindTexture(GL_TEXTURE_2D, RenderData->LoadedFonts[0].FontAtlas.TextureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, BITMAP_ATLAS_SIZE, BITMAP_ATLAS_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, TextureData);
-        
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 3);
-        
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
+    Timers->Issued[QuerySet] = true;
 }
 
-internal gl_shader_source
-CloverLoadShaderSource(memory_arena *Scratch, uint32 ShaderType, string Filepath)
+internal void
+CloverAdvanceRenderTimers(gl_render_data *RenderData)
 {
-    uint32 FileSize = 0;
-    gl_shader_source ReturnShader = {};
-    
-    string ShaderSource = ReadEntireFileMA(Scratch, Filepath, &FileSize);
-    ReturnShader.Filepath = Filepath;
-    
-    if(ShaderSource.Data)
+    render_timers *Timers = &RenderData->Timers;
+    Timers->QuerySet     = (Timers->QuerySet + 1) % RENDER_TIMER_BUFFERS;
+    Timers->HistoryIndex = (Timers->HistoryIndex + 1) % RENDER_TIMER_HISTORY;
+}
+
+// NOTE(Sleepster): LSD radix sort, a byte per pass. Any byte that's identical across every key gets skipped,
+//                  so in practice only the pass, texture and index bytes cost anything.
+internal void
+CloverRadixSortKeys(uint64 *Keys, uint64 *Scratch, uint32 Count)
+{
+    uint64 *Source = Keys;
+    uint64 *Dest   = Scratch;
+    for(uint32 ByteIndex = 0;
+        ByteIndex < 8;
+        ++ByteIndex)
     {
-        const char *ShaderSourceChar = (const char *)ShaderSource.Data;
+        uint32 Shift = ByteIndex * 8;
+        uint32 Offsets[256] = {};
+        for(uint32 KeyIndex = 0;
+            KeyIndex < Count;
+            ++KeyIndex)
+        {
+            ++Offsets[(Source[KeyIndex] >> Shift) & 0xFF];
+        }
+        if(Offsets[(Source[0] >> Shift) & 0xFF] == Count) continue;
+
+        uint32 Total = 0;
+        for(uint32 Bucket = 0;
+            Bucket < 256;
+            ++Bucket)
+        {
+            uint32 BucketCount = Offsets[Bucket];
+            Offsets[Bucket] = Total;
+            Total += BucketCount;
+        }
+
+        for(uint32 KeyIndex = 0;
+            KeyIndex < Count;
+            ++KeyIndex)
+        {
+            uint64 Key = Source[KeyIndex];
+            Dest[Offsets[(Key >> Shift) & 0xFF]++] = Key;
+        }
 
-        ReturnShader.SourceID = glCreateShader(ShaderType);
-        glShaderSource(ReturnShader.SourceID, 1, &ShaderSourceChar, 0);
-        glCompileShader(ReturnShader.SourceID);
-        glVerifyIVStatus(ReturnShader.SourceID, GL_VERTEX_SHADER);
+        uint64 *Temp = Source;
+        Source = Dest;
+        Dest   = Temp;
     }
-    else
+
+    if(Source != Keys)
     {
-        Trace("File is either not found or does not contain strings!\n");
-        Assert(false);
+        memcpy(Keys, Source, sizeof(uint64) * Count);
     }
-    return(ReturnShader);
 }
 
-internal shader
-CloverCreateShader(memory_arena *Memory, string VertexShader, string FragmentShader)
+// NOTE(Sleepster): No vertex or index data at all, every attribute steps once per instance and the
+//                  vertex shader builds the corners from gl_VertexID
+internal void
+CloverSetupInstanceAttributes()
 {
-    glUseProgram(0);
-    shader ReturnShader = {};
-    
-    ReturnShader.VertexShader   = CloverLoadShaderSource(Memory, GL_VERTEX_SHADER, VertexShader);
-    ReturnShader.FragmentShader = CloverLoadShaderSource(Memory, GL_FRAGMENT_SHADER, FragmentShader);
-    
-    ReturnShader.VertexShader.LastWriteTime   = Win32GetLastWriteTime(VertexShader);
-    ReturnShader.FragmentShader.LastWriteTime = Win32GetLastWriteTime(FragmentShader);
+    glVertexAttribPointer (0, 2, GL_FLOAT,          GL_FALSE, sizeof(sprite_instance), (void *)offsetof(sprite_instance, Position));
+    glVertexAttribPointer (1, 2, GL_HALF_FLOAT,     GL_FALSE, sizeof(sprite_instance), (void *)offsetof(sprite_instance, Size));
+    glVertexAttribPointer (2, 1, GL_HALF_FLOAT,     GL_FALSE, sizeof(sprite_instance), (void *)offsetof(sprite_instance, Rotation));
+    glVertexAttribPointer (3, 4, GL_UNSIGNED_BYTE,  GL_TRUE,  sizeof(sprite_instance), (void *)offsetof(sprite_instance, DrawColor));
+    glVertexAttribIPointer(4, 2, GL_UNSIGNED_BYTE,            sizeof(sprite_instance), (void *)offsetof(sprite_instance, TextureIndex));
+    glVertexAttribPointer (5, 3, GL_UNSIGNED_BYTE,  GL_TRUE,  sizeof(sprite_instance), (void *)offsetof(sprite_instance, AnimParams));
+    glVertexAttribPointer (6, 4, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(sprite_instance), (void *)offsetof(sprite_instance, AtlasRect));
     
-    ReturnShader.ShaderID = glCreateProgram();
-    glAttachShader(ReturnShader.ShaderID, ReturnShader.VertexShader.SourceID);
-    glAttachShader(ReturnShader.ShaderID, ReturnShader.FragmentShader.SourceID);
-    glLinkProgram(ReturnShader.ShaderID);
+    for(uint32 AttribIndex = 0;
+        AttribIndex <= 6;
+        ++AttribIndex)
+    {
+        glEnableVertexAttribArray(AttribIndex);
+        glVertexAttribDivisor(AttribIndex, 1);
+    }
+}
+
+// NOTE(Sleepster): The ring is UPLOAD_RING_REGIONS regions of Capacity instances, it stays mapped until it's outgrown
+internal void
+CloverCreateInstanceRing(gl_render_data *RenderData, uint32 Capacity)
+{
+    GLsizeiptr RingSize  = GLsizeiptr(sizeof(sprite_instance)) * Capacity * UPLOAD_RING_REGIONS;
+    GLbitfield RingFlags = GL_MAP_WRITE_BIT|GL_MAP_PERSISTENT_BIT|GL_MAP_COHERENT_BIT;
     
-    glVerifyIVStatus(ReturnShader.ShaderID, GL_PROGRAM);
+    glBindVertexArray(RenderData->GameVAOID);
     
-    glDetachShader(ReturnShader.ShaderID, ReturnShader.VertexShader.SourceID);
-    glDetachShader(ReturnShader.ShaderID, ReturnShader.FragmentShader.SourceID);
-    glDeleteShader(ReturnShader.VertexShader.SourceID);
-    glDeleteShader(ReturnShader.FragmentShader.SourceID);
+    glGenBuffers(1, &RenderData->GameVBOID);
+    glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameVBOID);
+    glBufferStorage(GL_ARRAY_BUFFER, RingSize, 0, RingFlags);
+    RenderData->GameInstanceRing = (sprite_instance *)glMapBufferRange(GL_ARRAY_BUFFER, 0, RingSize, RingFlags);
+    RenderData->InstanceRingCapacity = Capacity;
+    Assert(RenderData->GameInstanceRing);
     
-    return(ReturnShader);
+    CloverSetupInstanceAttributes();
 }
 
+// NOTE(Sleepster): Storage is immutable so growing means a brand new buffer. Every region has to be
+//                  out of flight before the old one goes away.
 internal void
-CloverLoadTexture(gl_render_data *RenderData, texture2d *TextureInfo, string Filepath)
+CloverGrowInstanceRing(gl_render_data *RenderData, uint32 RequiredCapacity)
 {
-    glActiveTexture(GL_TEXTURE0 + RenderData->TextureCount);
-    RenderData->TextureCount++;
+    for(uint32 Region = 0;
+        Region < UPLOAD_RING_REGIONS;
+        ++Region)
+    {
+        RenderData->DrawFrame.UploadRegion = Region;
+        CloverAcquireUploadRegion(RenderData);
+    }
+    RenderData->DrawFrame.UploadRegion = 0;
+    
+    uint32 NewCapacity = RenderData->InstanceRingCapacity;
+    while(NewCapacity < RequiredCapacity)
+    {
+        NewCapacity *= 2;
+    }
     
-    glGenTextures(1, &TextureInfo->TextureID);
-    glBindTexture(GL_TEXTURE_2D, TextureInfo->TextureID);
+    glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameVBOID);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glDeleteBuffers(1, &RenderData->GameVBOID);
     
-    TextureInfo->Filepath = Filepath;
-    TextureInfo->LastWriteTime = Win32GetLastWriteTime(Filepath);
-    TextureInfo->RawData = (char *)stbi_load((const char *)Filepath.Data, 
-                                             &TextureInfo->TextureData.Width, 
-                                             &TextureInfo->TextureData.Height, 
-                                             &TextureInfo->TextureData.Channels, 
-                                             4);
-    if(TextureInfo->RawData)
-    {
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB_ALPHA, 
-                     TextureInfo->TextureData.Width, TextureInfo->TextureData.Height, 0, 
-                     GL_RGBA, GL_UNSIGNED_BYTE, TextureInfo->RawData);
+    CloverCreateInstanceRing(RenderData, NewCapacity);
+}
+
+// NOTE(Sleepster): Light positions and radii are already in clip space, so a light covers an ellipse of Radius * Width / 2 
+//                  by Radius * Height / 2 pixels. Returns false for lights that don't touch the screen.
+internal bool8
+CloverGetLightTileRect(point_light *Light, uint32 TileCountX, uint32 TileCountY, light_tile_rect *TileRect)
+{
+    real32 MinX = ((Light->Position.X - Light->Radius) * 0.5f + 0.5f) * SizeData.Width;
+    real32 MaxX = ((Light->Position.X + Light->Radius) * 0.5f + 0.5f) * SizeData.Width;
+    real32 MinY = ((Light->Position.Y - Light->Radius) * 0.5f + 0.5f) * SizeData.Height;
+    real32 MaxY = ((Light->Position.Y + Light->Radius) * 0.5f + 0.5f) * SizeData.Height;
+    if(MaxX < 0 || MaxY < 0 || MinX >= SizeData.Width || MinY >= SizeData.Height)
+    {
+        return(false);
     }
-    stbi_image_free(TextureInfo->RawData);
-    glBindTexture(GL_TEXTURE_2D, 0);
+
+    TileRect->MinX = MAX(int32(MinX) / int32(LIGHT_TILE_SIZE), 0);
+    TileRect->MinY = MAX(int32(MinY) / int32(LIGHT_TILE_SIZE), 0);
+    TileRect->MaxX = MIN(int32(MaxX) / int32(LIGHT_TILE_SIZE), int32(TileCountX) - 1);
+    TileRect->MaxY = MIN(int32(MaxY) / int32(LIGHT_TILE_SIZE), int32(TileCountY) - 1);
+    return(true);
 }
 
+// NOTE(Sleepster): Bins this frame's point lights into LIGHT_TILE_SIZE screen tiles. One pass counts the lights per tile,
+//                  a prefix sum turns the counts into offsets and a second pass fills the packed index list, so there's 
+//                  no per tile cap. Basic.frag then only walks the lights of the tile its fragment is in.
 internal void
-CloverReloadTexture(gl_render_data *RenderData, texture2d *TextureInfo, uint32 TextureIndex)
+CloverBinPointLights(gl_render_data *RenderData)
 {
-    glBindTexture(GL_TEXTURE_2D, TextureInfo->TextureID);
-    
-    TextureInfo->LastWriteTime = Win32GetLastWriteTime(TextureInfo->Filepath);
-    TextureInfo->RawData = (char *)stbi_load((const char *)TextureInfo->Filepath.Data, 
-                                             &TextureInfo->TextureData.Width, 
-                                             &TextureInfo->TextureData.Height, 
-                                             &TextureInfo->TextureData.Channels, 
-                                             4);
-    if(TextureInfo->RawData)
-    {
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 
-                     TextureInfo->TextureData.Width, TextureInfo->TextureData.Height, 0, 
-                     GL_RGBA, GL_UNSIGNED_BYTE, TextureInfo->RawData);
+    uint32 TileCountX = (SizeData.Width  + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE;
+    uint32 TileCountY = (SizeData.Height + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE;
+    uint32 TileCount  = TileCountX * TileCountY;
+    uint32 LightCount = RenderData->DrawFrame.PointLightCount;
+
+    memory_arena    *FrameArena = RenderData->FrameArena;
+    light_tile      *Tiles      = (light_tile *)ArenaAlloc(FrameArena, sizeof(light_tile) * TileCount);
+    light_tile_rect *TileRects  = (light_tile_rect *)ArenaAlloc(FrameArena, sizeof(light_tile_rect) * (LightCount + 1));
+    bool8           *OnScreen   = (bool8 *)ArenaAlloc(FrameArena, sizeof(bool8) * (LightCount + 1));
+    Assert(Tiles && TileRects && OnScreen);
+    memset(Tiles, 0, sizeof(light_tile) * TileCount);
+
+    for(uint32 LightIndex = 0;
+        LightIndex < LightCount;
+        ++LightIndex)
+    {
+        light_tile_rect *Rect = &TileRects[LightIndex];
+        OnScreen[LightIndex] = CloverGetLightTileRect(&RenderData->DrawFrame.PointLights[LightIndex], TileCountX, TileCountY, Rect);
+        if(!OnScreen[LightIndex]) continue;
+
+        for(int32 TileY = Rect->MinY;
+            TileY <= Rect->MaxY;
+            ++TileY)
+        {
+            for(int32 TileX = Rect->MinX;
+                TileX <= Rect->MaxX;
+                ++TileX)
+            {
+                ++Tiles[TileY * TileCountX + TileX].Count;
+            }
+        }
+    }
+
+    uint32 IndexCount = 0;
+    for(uint32 TileIndex = 0;
+        TileIndex < TileCount;
+        ++TileIndex)
+    {
+        Tiles[TileIndex].First = IndexCount;
+        IndexCount += Tiles[TileIndex].Count;
+        Tiles[TileIndex].Count = 0;
+    }
+
+    uint32 *LightIndices = (uint32 *)ArenaAlloc(FrameArena, sizeof(uint32) * (IndexCount + 1));
+    Assert(LightIndices);
+    for(uint32 LightIndex = 0;
+        LightIndex < LightCount;
+        ++LightIndex)
+    {
+        if(!OnScreen[LightIndex]) continue;
+
+        light_tile_rect *Rect = &TileRects[LightIndex];
+        for(int32 TileY = Rect->MinY;
+            TileY <= Rect->MaxY;
+            ++TileY)
+        {
+            for(int32 TileX = Rect->MinX;
+                TileX <= Rect->MaxX;
+                ++TileX)
+            {
+                light_tile *Tile = &Tiles[TileY * TileCountX + TileX];
+                LightIndices[Tile->First + Tile->Count++] = LightIndex;
+            }
+        }
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, RenderData->PointLightSBOID);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(point_light) * LightCount, RenderData->DrawFrame.PointLights);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, RenderData->LightTileSBOID);
+    if(TileCount > RenderData->LightTileCapacity)
+    {
+        while(RenderData->LightTileCapacity < TileCount) RenderData->LightTileCapacity *= 2;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(light_tile) * RenderData->LightTileCapacity, 0, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(light_tile) * TileCount, Tiles);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, RenderData->LightIndexSBOID);
+    if(IndexCount > RenderData->LightIndexCapacity)
+    {
+        while(RenderData->LightIndexCapacity < IndexCount) RenderData->LightIndexCapacity *= 2;
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(uint32) * RenderData->LightIndexCapacity, 0, GL_DYNAMIC_DRAW);
     }
-    stbi_image_free(TextureInfo->RawData);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(uint32) * IndexCount, LightIndices);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    RenderData->DrawFrame.LightTileCountX = TileCountX;
 }
 
+// NOTE(Sleepster): Locations change whenever a program is relinked, so this runs again after every shader reload
 internal void
-CloverResetRendererState(gl_render_data *RenderData)
+CloverGetShaderUniforms(gl_render_data *RenderData)
 {
-    RenderData->DrawFrame.VertexBufferptr            = &RenderData->DrawFrame.Vertices[0];
-    RenderData->DrawFrame.TransparentVertexBufferptr = &RenderData->DrawFrame.Vertices[int32(MAX_VERTICES * 0.5f)];
-    RenderData->DrawFrame.OpaqueQuadCount = 0;
-    RenderData->DrawFrame.TransparentQuadCount = 0;
-    RenderData->DrawFrame.TotalQuadCount = 0;
-    
-    RenderData->DrawFrame.UIVertexBufferptr            = &RenderData->DrawFrame.UIVertices[0];
-    RenderData->DrawFrame.TransparentUIVertexBufferptr = &RenderData->DrawFrame.UIVertices[int32(MAX_VERTICES * 0.5f)];
-    RenderData->DrawFrame.OpaqueUIElementCount = 0;
-    RenderData->DrawFrame.TransparentUIElementCount = 0;
-    RenderData->DrawFrame.TotalUIElementCount = 0;
+    RenderData->gBufferProjectionMatrixUID   = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "ProjectionMatrix");
+    RenderData->gBufferViewMatrixUID         = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "ViewMatrix");
+    RenderData->gBufferBrightnessUID         = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "uBrightness");
+    RenderData->gBufferTimeUID               = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "uTime");
 
-    RenderData->DrawFrame.PointLightCount = 0;
-    RenderData->DrawFrame.SpotLightCount = 0;
+    RenderData->ProjectionMatrixUID          = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "ProjectionMatrix");
+    RenderData->ViewMatrixUID                = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "ViewMatrix");
+    RenderData->BasicShaderBrightnessUID     = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "uBrightness");
+    RenderData->BasicShaderTimeUID           = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "uTime");
+ 
+    RenderData->LightTileCountXUID           = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "LightTileCountX");
 }
 
-internal int32
-CompareVertexYAxis(const void *A, const void *B)
+// NOTE(Sleepster): Only relinks the programs whose sources changed, unless CommonShader.glh changed which touches all of them
+internal void
+CloverReloadShaders(memory_arena *Memory, gl_render_data *RenderData)
 {
-    const vertex *VertexA = (vertex *)A;
-    const vertex *VertexB = (vertex *)B;
-    
-    return((VertexA->Position.Y > VertexB->Position.Y) ? -1 :
-           (VertexA->Position.Y < VertexB->Position.Y) ?  1 : 0);
+    FILETIME CommonWriteTime = Win32GetLastWriteTime(COMMON_SHADER_PATH);
+    bool8    CommonChanged   = CompareFileTime(&CommonWriteTime, &RenderData->CommonShaderLastWriteTime) != 0;
+    if(CommonChanged)
+    {
+        CloverRegisterCommonShader(Memory, RenderData);
+    }
+
+    shader *Shaders[] = 
+    {
+        &RenderData->BasicShader,
+        &RenderData->gBufferShader,
+        &RenderData->LightingShader,
+        &RenderData->CombinationShader,
+    };
+
+    bool8 Relinked = false;
+    for(uint32 ShaderIndex = 0;
+        ShaderIndex < ArrayCount(Shaders);
+        ++ShaderIndex)
+    {
+        shader  *Shader = Shaders[ShaderIndex];
+        FILETIME VertexWriteTime   = Win32GetLastWriteTime(Shader->VertexShader.Filepath);
+        FILETIME FragmentWriteTime = Win32GetLastWriteTime(Shader->FragmentShader.Filepath);
+        if(CommonChanged ||
+           CompareFileTime(&VertexWriteTime,   &Shader->VertexShader.LastWriteTime) != 0 ||
+           CompareFileTime(&FragmentWriteTime, &Shader->FragmentShader.LastWriteTime) != 0)
+        {
+            glDeleteProgram(Shader->ShaderID);
+            *Shader  = CloverCreateShader(Memory, RenderData, Shader->VertexShader.Filepath, Shader->FragmentShader.Filepath);
+            Relinked = true;
+        }
+    }
+
+    if(Relinked)
+    {
+        CloverGetShaderUniforms(RenderData);
+    }
 }
 
 internal void
@@ -416,78 +1384,17 @@ CloverSetupRenderer(memory_arena *Memory, gl_render_data *RenderData)
         glDisable(0x809D); // Disabling multisampling
         
         RenderData->ClearColor = DARK_GRAY;
-        RenderData->TextureCount = 1;
-    }
-    
-    
-    uint32 Indices[MAX_INDICES] = {};
-    uint32 Offset               = 0;
-    for(uint32 Index = 0;
-        Index < MAX_INDICES;
-        Index += 6)
-    {
-        Indices[Index + 0] = Offset + 0;
-        Indices[Index + 1] = Offset + 1;
-        Indices[Index + 2] = Offset + 2;
-        Indices[Index + 3] = Offset + 2;
-        Indices[Index + 4] = Offset + 3;
-        Indices[Index + 5] = Offset + 0;
-        Offset += 4;
     }
     
     
     // GAME ASSETS BUFFER SETUP
     {
         glGenVertexArrays(1, &RenderData->GameVAOID);
-        glBindVertexArray(RenderData->GameVAOID);
-        
-        glGenBuffers(1, &RenderData->GameVBOID);
-        glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameVBOID);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertex) * MAX_VERTICES, 0, GL_DYNAMIC_DRAW);
-        
-        glGenBuffers(1, &RenderData->GameEBOID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, RenderData->GameEBOID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(Indices), Indices, GL_STATIC_DRAW);
-        
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, Position));
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, TextureCoords));
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, VertexNormals));
-        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, DrawColor));
-        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, TextureIndex));
-        
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-        glEnableVertexAttribArray(3);
-        glEnableVertexAttribArray(4);
+        glGenVertexArrays(1, &RenderData->EmptyVAOID);
+        glGenQueries(RENDER_TIMER_BUFFERS * RENDER_TIMER_Count, &RenderData->Timers.Queries[0][0]);
+        CloverCreateInstanceRing(RenderData, DEFAULT_INSTANCE_RING_CAPACITY);
     }
     
-    // GAME UI BUFFER SETUP
-    {
-        glGenVertexArrays(1, &RenderData->GameUIVAOID);
-        glBindVertexArray(RenderData->GameUIVAOID);
-        
-        glGenBuffers(1, &RenderData->GameUIVBOID);
-        glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameUIVBOID);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertex) * MAX_VERTICES, 0, GL_DYNAMIC_DRAW);
-        
-        glGenBuffers(1, &RenderData->GameUIEBOID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, RenderData->GameUIEBOID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(Indices), Indices, GL_STATIC_DRAW);
-        
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, Position));
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, TextureCoords));
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, VertexNormals));
-        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, DrawColor));
-        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(vertex), (void *)offsetof(vertex, TextureIndex));
-        
-        glEnableVertexAttribArray(0);
-        glEnableVertexAttribArray(1);
-        glEnableVertexAttribArray(2);
-        glEnableVertexAttribArray(3);
-        glEnableVertexAttribArray(4);
-    }
-
     // GBUFFER FRAMEBUFFER
     {
         glCreateFramebuffers(2, RenderData->gBuffer); 
@@ -524,24 +1431,50 @@ CloverSetupRenderer(memory_arena *Memory, gl_render_data *RenderData)
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
+    // LIGHTING FRAMEBUFFER
+    {
+        glCreateFramebuffers(1, &RenderData->LightingFBOID);
+        glBindFramebuffer(GL_FRAMEBUFFER, RenderData->LightingFBOID);
+
+        glGenTextures(1, &RenderData->LightmapID);
+        glBindTexture(GL_TEXTURE_2D, RenderData->LightmapID);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, SizeData.Width, SizeData.Height, 0, GL_RGBA, GL_FLOAT, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, RenderData->LightmapID, 0);
+        if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            Check(0, "Framebuffer Failure\n");
+        }
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
     // TEXTURE/FONT LOADING
     {
-        // NOTE(Sleepster): The order is important, whatever you gen first will end up in the GL_TEXTUREX slot 
-        CloverLoadTexture(RenderData, &RenderData->GameAtlas, STR("../data/res/textures/TextureAtlas.png"));
-        CloverLoadSDFFont(Memory, RenderData, STR("../data/res/fonts/UbuntuMono-B.ttf"), 48, UBUNTU_MONO);
+        CloverCreateAtlasArrays(RenderData);
+        CloverCreateTextureStaging(RenderData);
+
+        CloverInitGlyphCache(RenderData);
+        CloverInitTextLayoutCache(RenderData);
+        CloverLoadSDFFont(RenderData, STR("../data/res/fonts/UbuntuMono-B.ttf"), 48, UBUNTU_MONO);
     }
 
     // SHADER SETUP
     {
         // NOTE(Sleepster): This is for the common shader includes 
-        uint32 Size = {};
-        string CommonGLHeader = ReadEntireFileMA(Memory, STR("../code/shader/CommonShader.glh"), &Size);
-        glNamedStringARB(GL_SHADER_INCLUDE_ARB, -1, "/../code/shader/CommonShader.glh", int32(CommonGLHeader.Length), CSTR(CommonGLHeader));
+        CloverRegisterCommonShader(Memory, RenderData);
 
         RenderData->BasicShader = 
-            CloverCreateShader(Memory, STR("../code/shader/Basic.vert"), STR("../code/shader/Basic.frag"));
+            CloverCreateShader(Memory, RenderData, STR("../code/shader/Basic.vert"), STR("../code/shader/Basic.frag"));
         RenderData->gBufferShader = 
-            CloverCreateShader(Memory, STR("../code/shader/gBuffer_Geo.vert"), STR("../code/shader/gBuffer_Geo.frag"));
+            CloverCreateShader(Memory, RenderData, STR("../code/shader/gBuffer_Geo.vert"), STR("../code/shader/gBuffer_Geo.frag"));
+        RenderData->LightingShader = 
+            CloverCreateShader(Memory, RenderData, STR("../code/shader/Lighting.vert"), STR("../code/shader/Lighting.frag"));
+        RenderData->CombinationShader = 
+            CloverCreateShader(Memory, RenderData, STR("../code/shader/Combination.vert"), STR("../code/shader/Combination.frag"));
     }
 
     // SHADER UNIFORM / STORAGE BUFFER SETUP
@@ -549,16 +1482,7 @@ CloverSetupRenderer(memory_arena *Memory, gl_render_data *RenderData)
         RenderData->GameCamera.ViewMatrix   = mat4Identity(1.0f);
         RenderData->GameUICamera.ViewMatrix = mat4Identity(1.0f);
 
-        RenderData->gBufferProjectionMatrixUID   = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "ProjectionMatrix");
-        RenderData->gBufferViewMatrixUID         = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "ViewMatrix");
-        RenderData->gBufferBrightnessUID         = glGetUniformLocation(RenderData->gBufferShader.ShaderID,  "uBrightness");
-
-        RenderData->ProjectionMatrixUID          = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "ProjectionMatrix");
-        RenderData->ViewMatrixUID                = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "ViewMatrix");
-        RenderData->BasicShaderBrightnessUID     = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "uBrightness");
- 
-        RenderData->PointLightSBOID              = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "PointLightSBO");
-        RenderData->PointLightCountUID           = glGetUniformLocation(RenderData->BasicShader.ShaderID,    "PointLightCount");
+        CloverGetShaderUniforms(RenderData);
 
         // NOTE(Sleepster): Point Light Shader Buffer
         uint64 MaxBufferSize = sizeof(struct point_light) * MAX_POINT_LIGHTS;
@@ -569,71 +1493,193 @@ CloverSetupRenderer(memory_arena *Memory, gl_render_data *RenderData)
         // NOTE(Sleepster): Spot Light Shader Buffer
         MaxBufferSize = sizeof(struct spot_light) * MAX_SPOT_LIGHTS;
         glGenBuffers(1, &RenderData->SpotLightSBOID);
-        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, RenderData->SpotLightSBOID);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, RenderData->SpotLightSBOID);
         glBufferData(GL_SHADER_STORAGE_BUFFER, MaxBufferSize, 0, GL_DYNAMIC_DRAW);
 
+        // NOTE(Sleepster): Light Tile Shader Buffers, filled by CloverBinPointLights every frame
+        RenderData->LightTileCapacity  = DEFAULT_LIGHT_TILE_CAPACITY;
+        RenderData->LightIndexCapacity = DEFAULT_LIGHT_INDEX_CAPACITY;
+
+        glGenBuffers(1, &RenderData->LightTileSBOID);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, RenderData->LightTileSBOID);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(light_tile) * RenderData->LightTileCapacity, 0, GL_DYNAMIC_DRAW);
+
+        glGenBuffers(1, &RenderData->LightIndexSBOID);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, RenderData->LightIndexSBOID);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(uint32) * RenderData->LightIndexCapacity, 0, GL_DYNAMIC_DRAW);
+
         glBindTexture(GL_TEXTURE_2D, 0);
         glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
     }
 }
 
+// NOTE(Sleepster): Sorts the frame's keys and scatters the instances into Dest in key order, every pass comes out
+//                  contiguous. Any backend that consumes DrawFrame starts here.
+internal void
+CloverSortQueuedInstances(gl_render_data *RenderData, sprite_instance *Dest, uint32 *PassFirst, uint32 *PassCount)
+{
+    uint32         QueuedCount = RenderData->DrawFrame.QueuedQuadCount;
+    memory_arena  *FrameArena  = RenderData->FrameArena;
+    render_chunk **Chunks      = (render_chunk **)ArenaAlloc(FrameArena, sizeof(render_chunk *) * RenderData->DrawFrame.ChunkCount);
+    uint64        *SortKeys    = (uint64 *)ArenaAlloc(FrameArena, sizeof(uint64) * QueuedCount);
+    uint64        *SortScratch = (uint64 *)ArenaAlloc(FrameArena, sizeof(uint64) * QueuedCount);
+    Assert(Chunks && SortKeys && SortScratch);
+    
+    uint32 ChunkIndex = 0;
+    for(render_chunk *Chunk = RenderData->DrawFrame.FirstChunk;
+        Chunk;
+        Chunk = Chunk->Next)
+    {
+        uint32 ChunkFirst = ChunkIndex << RENDER_CHUNK_SHIFT;
+        uint32 ChunkQuads = MIN(QueuedCount - ChunkFirst, RENDER_CHUNK_QUADS);
+        memcpy(&SortKeys[ChunkFirst], Chunk->SortKeys, sizeof(uint64) * ChunkQuads);
+        
+        Chunks[ChunkIndex++] = Chunk;
+    }
+    CloverRadixSortKeys(SortKeys, SortScratch, QueuedCount);
+    
+    for(uint32 KeyIndex = 0;
+        KeyIndex < QueuedCount;
+        ++KeyIndex)
+    {
+        uint64 Key             = SortKeys[KeyIndex];
+        uint32 SubmissionIndex = uint32(Key & SORT_KEY_INDEX_MASK);
+        
+        Dest[KeyIndex] = Chunks[SubmissionIndex >> RENDER_CHUNK_SHIFT]->Instances[SubmissionIndex & RENDER_CHUNK_MASK];
+        ++PassCount[Key >> SORT_KEY_PASS_SHIFT];
+    }
+    
+    PassFirst[0] = 0;
+    for(uint32 Pass = 1;
+        Pass < RENDER_PASS_Count;
+        ++Pass)
+    {
+        PassFirst[Pass] = PassFirst[Pass - 1] + PassCount[Pass - 1];
+    }
+}
+
 internal void
 CloverRender(gl_render_data *RenderData)
 {
-    // NOTE(Sleepster): Figure out this offset  
+    uint32 QueuedCount = RenderData->DrawFrame.QueuedQuadCount;
+    uint32 RegionBase  = 0;
+    uint32 PassFirst[RENDER_PASS_Count] = {};
+    uint32 PassCount[RENDER_PASS_Count] = {};
+
+    CloverCollectRenderTimers(RenderData);
+    CloverBinPointLights(RenderData);
+
+    // NOTE(Sleepster): Every atlas page is in one of these two arrays, they stay bound for every pass this frame.
+    //                  The deferred passes use the GL_TEXTURE_2D targets on the same units so they don't disturb them.
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, RenderData->SpriteAtlasArrayID);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, RenderData->FontAtlasArrayID);
+    
+    // NOTE(Sleepster): Gather the keys out of the chunks, sort them and scatter the instances into the ring in key order.
+    //                  Passes come out contiguous, and since both atlases stay bound with the texture picked per instance
+    //                  each pass is one draw.
+    if(QueuedCount > 0)
+    {
+        if(QueuedCount > RenderData->InstanceRingCapacity)
+        {
+            CloverGrowInstanceRing(RenderData, QueuedCount);
+        }
+        CloverAcquireUploadRegion(RenderData);
+        
+        RegionBase = RenderData->DrawFrame.UploadRegion * RenderData->InstanceRingCapacity;
+        CloverSortQueuedInstances(RenderData, &RenderData->GameInstanceRing[RegionBase], PassFirst, PassCount);
+    }
+    
     // OPAQUE GAME OBJECT RENDERING PASS
+    CloverBeginRenderTimer(RenderData, RENDER_TIMER_GameOpaque);
     glUseProgram(RenderData->gBufferShader.ShaderID);
-    if(RenderData->DrawFrame.OpaqueQuadCount > 0)
     {
-        {
-            glBindFramebuffer(GL_FRAMEBUFFER, RenderData->gBuffer[0]);
+        glBindFramebuffer(GL_FRAMEBUFFER, RenderData->gBuffer[0]);
 
-            glEnable(GL_FRAMEBUFFER_SRGB);
-            glDisable(0x809D); // Disabling multisampling
- 
-            glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
+        glEnable(GL_FRAMEBUFFER_SRGB);
+        glDisable(0x809D); // Disabling multisampling
+
+        // NOTE(Sleepster): Cleared even when nothing opaque was queued, the lighting and combination passes still
+        //                  read the g-buffer and would pick up last frame's sprites otherwise
+        glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
+
+        // NOTE(Sleepster): The lighting pass treats a zero normal as empty space
+        const real32 ClearNormal[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 1, ClearNormal);
 
+        if(PassCount[RENDER_PASS_GameOpaque] > 0)
+        {
             glEnable(GL_BLEND);        
             glBlendEquation(GL_FUNC_ADD);
             glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
                 
             glEnable(GL_DEPTH_TEST);
-            glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameVBOID);
-            glBufferSubData(GL_ARRAY_BUFFER, 
-                            0, 
-                            (RenderData->DrawFrame.OpaqueQuadCount * 4) * sizeof(vertex), 
-                            RenderData->DrawFrame.Vertices);
-
             glUniformMatrix4fv(RenderData->gBufferProjectionMatrixUID, 1, GL_FALSE, &RenderData->GameCamera.ProjectionMatrix.Elements[0][0]);
             glUniformMatrix4fv(RenderData->gBufferViewMatrixUID, 1, GL_FALSE, &RenderData->GameCamera.ViewMatrix.Elements[0][0]);
 
             glUniform1f(RenderData->gBufferBrightnessUID, RenderBrightness);
-
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, RenderData->GameAtlas.TextureID);
-
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, RenderData->LoadedFonts[UBUNTU_MONO].FontAtlas.TextureID);
+            glUniform1f(RenderData->gBufferTimeUID, RenderData->AnimationTime);
 
             glBindVertexArray(RenderData->GameVAOID);
-            glDrawElements(GL_TRIANGLES, 
-                        RenderData->DrawFrame.OpaqueQuadCount * 6, 
-                        GL_UNSIGNED_INT, 
-                        0); 
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 6, 
+                                              PassCount[RENDER_PASS_GameOpaque], 
+                                              RegionBase + PassFirst[RENDER_PASS_GameOpaque]);
         }
     }
+    CloverEndRenderTimer(RenderData, RENDER_TIMER_GameOpaque);
     
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, RenderData->gBuffer[0]);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-    glBlitFramebuffer(0, 0, SizeData.Width, SizeData.Height, 0, 0, SizeData.Width, SizeData.Height, GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // DEFERRED LIGHTING PASS
+    // NOTE(Sleepster): Each point light draws a quad bounding its radius, additively into the lightmap.
+    //                  Cost is the pixels each light covers rather than sprites times lights.
+    CloverBeginRenderTimer(RenderData, RENDER_TIMER_Lighting);
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, RenderData->LightingFBOID);
+        glDisable(GL_DEPTH_TEST);
+
+        const real32 ClearLight[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        glClearBufferfv(GL_COLOR, 0, ClearLight);
+
+        if(RenderData->DrawFrame.PointLightCount > 0)
+        {
+            glUseProgram(RenderData->LightingShader.ShaderID);
+
+            glEnable(GL_BLEND);
+            glBlendEquation(GL_FUNC_ADD);
+            glBlendFunc(GL_ONE, GL_ONE);
+
+            glActiveTexture(GL_TEXTURE2);
+            glBindTexture(GL_TEXTURE_2D, RenderData->gBufferTextures[1]);
+
+            glBindVertexArray(RenderData->EmptyVAOID);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, 6, RenderData->DrawFrame.PointLightCount);
+        }
+    }
+    CloverEndRenderTimer(RenderData, RENDER_TIMER_Lighting);
+
+    // COMBINATION PASS
+    CloverBeginRenderTimer(RenderData, RENDER_TIMER_Combination);
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glUseProgram(RenderData->CombinationShader.ShaderID);
+        glDisable(GL_BLEND);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, RenderData->gBufferTextures[0]);
+
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, RenderData->LightmapID);
+
+        glBindVertexArray(RenderData->EmptyVAOID);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+    CloverEndRenderTimer(RenderData, RENDER_TIMER_Combination);
 
     glUseProgram(RenderData->BasicShader.ShaderID);
 
-    if(RenderData->DrawFrame.TransparentQuadCount > 0)
+    CloverBeginRenderTimer(RenderData, RENDER_TIMER_GameTransparent);
+    if(PassCount[RENDER_PASS_GameTransparent] > 0)
     {
-        GLintptr BufferOffset   =  (RenderData->DrawFrame.OpaqueQuadCount * 4) * sizeof(vertex);
-        GLintptr ElementOffset  =  (RenderData->DrawFrame.OpaqueQuadCount * 6) * sizeof(uint32); 
         // TRANSPARENT GAME OBJECT RENDERERING PASS
         {
             glDisable(GL_DEPTH_TEST);
@@ -642,33 +1688,23 @@ CloverRender(gl_render_data *RenderData)
             glBlendEquation(GL_FUNC_ADD);
             glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-            glBufferSubData(GL_ARRAY_BUFFER, 
-                            BufferOffset, 
-                            (RenderData->DrawFrame.TransparentQuadCount * 4) * sizeof(vertex), 
-                            &RenderData->DrawFrame.Vertices[int32(MAX_VERTICES * 0.5f)]);
-
             glUniformMatrix4fv(RenderData->ProjectionMatrixUID, 1, GL_FALSE, &RenderData->GameCamera.ProjectionMatrix.Elements[0][0]);
             glUniformMatrix4fv(RenderData->ViewMatrixUID, 1, GL_FALSE, &RenderData->GameCamera.ViewMatrix.Elements[0][0]);
             glUniform1f(RenderData->BasicShaderBrightnessUID, RenderBrightness);
-
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, RenderData->GameAtlas.TextureID);
-
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, RenderData->LoadedFonts[UBUNTU_MONO].FontAtlas.TextureID);
+            glUniform1f(RenderData->BasicShaderTimeUID, RenderData->AnimationTime);
+            glUniform1ui(RenderData->LightTileCountXUID, RenderData->DrawFrame.LightTileCountX);
 
             glBindVertexArray(RenderData->GameVAOID);
-            glDrawElements(GL_TRIANGLES, 
-                        RenderData->DrawFrame.TransparentQuadCount * 6, 
-                        GL_UNSIGNED_INT, 
-                        (void*)ElementOffset);
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 6, 
+                                              PassCount[RENDER_PASS_GameTransparent], 
+                                              RegionBase + PassFirst[RENDER_PASS_GameTransparent]);
         }
     }
+    CloverEndRenderTimer(RenderData, RENDER_TIMER_GameTransparent);
     
-    if(RenderData->DrawFrame.TransparentUIElementCount > 0)
+    CloverBeginRenderTimer(RenderData, RENDER_TIMER_UI);
+    if(PassCount[RENDER_PASS_UITransparent] > 0)
     {
-        GLintptr UIBufferOffset   = int32((RenderData->DrawFrame.OpaqueUIElementCount * 4) * sizeof(vertex));
-        GLintptr UIElementOffset  = (RenderData->DrawFrame.OpaqueUIElementCount * 6) * sizeof(uint32); 
         // TRANSPARENT UI RENDERING PASS
         {
             glDisable(GL_DEPTH_TEST);
@@ -676,59 +1712,47 @@ CloverRender(gl_render_data *RenderData)
             glBlendEquation(GL_FUNC_ADD);
             glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
-            glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameUIVBOID);
-            glBufferSubData(GL_ARRAY_BUFFER, 
-                            UIBufferOffset, 
-                            (RenderData->DrawFrame.TransparentUIElementCount * 4) * sizeof(vertex), 
-                            &RenderData->DrawFrame.UIVertices[int32(MAX_VERTICES * 0.5f)]);
-
             glUniformMatrix4fv(RenderData->ProjectionMatrixUID, 1, GL_FALSE, &RenderData->GameUICamera.ProjectionMatrix.Elements[0][0]);
             glUniformMatrix4fv(RenderData->ViewMatrixUID, 1, GL_FALSE, &RenderData->GameUICamera.ViewMatrix.Elements[0][0]);
             glUniform1f(RenderData->BasicShaderBrightnessUID, RenderBrightness);
+            glUniform1f(RenderData->BasicShaderTimeUID, RenderData->AnimationTime);
+            glUniform1ui(RenderData->LightTileCountXUID, RenderData->DrawFrame.LightTileCountX);
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, RenderData->GameAtlas.TextureID);
-
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, RenderData->LoadedFonts[UBUNTU_MONO].FontAtlas.TextureID);
-
-            glBindVertexArray(RenderData->GameUIVAOID);
-            glDrawElements(GL_TRIANGLES, 
-                        RenderData->DrawFrame.TransparentUIElementCount * 6, 
-                        GL_UNSIGNED_INT, 
-                        (void *)UIElementOffset); 
+            glBindVertexArray(RenderData->GameVAOID);
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 6, 
+                                              PassCount[RENDER_PASS_UITransparent], 
+                                              RegionBase + PassFirst[RENDER_PASS_UITransparent]);
         }
     }
     
-    if(RenderData->DrawFrame.OpaqueUIElementCount > 0)
+    if(PassCount[RENDER_PASS_UIOpaque] > 0)
     {
         // OPAQUE UI RENDERING PASS
         {
             glDisable(GL_DEPTH_TEST);
 
-            glBindBuffer(GL_ARRAY_BUFFER, RenderData->GameUIVBOID);
-            glBufferSubData(GL_ARRAY_BUFFER, 
-                            0, 
-                            (RenderData->DrawFrame.OpaqueUIElementCount * 4) * sizeof(vertex), 
-                            RenderData->DrawFrame.UIVertices);
-
             glUniformMatrix4fv(RenderData->ProjectionMatrixUID, 1, GL_FALSE, &RenderData->GameUICamera.ProjectionMatrix.Elements[0][0]);
             glUniformMatrix4fv(RenderData->ViewMatrixUID, 1, GL_FALSE, &RenderData->GameUICamera.ViewMatrix.Elements[0][0]);
             glUniform1f(RenderData->BasicShaderBrightnessUID, RenderBrightness);
+            glUniform1f(RenderData->BasicShaderTimeUID, RenderData->AnimationTime);
+            glUniform1ui(RenderData->LightTileCountXUID, RenderData->DrawFrame.LightTileCountX);
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, RenderData->GameAtlas.TextureID);
-
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, RenderData->LoadedFonts[UBUNTU_MONO].FontAtlas.TextureID);
-
-            glBindVertexArray(RenderData->GameUIVAOID);
-            glDrawElements(GL_TRIANGLES, 
-                        RenderData->DrawFrame.OpaqueUIElementCount * 6, 
-                        GL_UNSIGNED_INT, 
-                        0); 
+            glBindVertexArray(RenderData->GameVAOID);
+            glDrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 6, 
+                                              PassCount[RENDER_PASS_UIOpaque], 
+                                              RegionBase + PassFirst[RENDER_PASS_UIOpaque]);
         }
     }
+    CloverEndRenderTimer(RenderData, RENDER_TIMER_UI);
+
+    // NOTE(Sleepster): Fence the region these draws read from and move on to the next one
+    if(QueuedCount > 0)
+    {
+        uint32 Region = RenderData->DrawFrame.UploadRegion;
+        RenderData->DrawFrame.UploadFences[Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        RenderData->DrawFrame.UploadRegion = (Region + 1) % UPLOAD_RING_REGIONS;
+    }
 
+    CloverAdvanceRenderTimers(RenderData);
     CloverResetRendererState(RenderData);
 }
@@ -19,6 +19,7 @@
 #include "util/Math.h"
 #include "util/Array.h"
 #include "util/FileIO.h"
+#include "util/MemoryArena.h"
 #include "util/CustomStrings.h"
 
 #include "../data/deps/OpenGL/glext.h"
@@ -33,6 +34,10 @@
 #include "Clover.h"
 #include "shader/CommonShader.glh"
 #include "Clover_Globals.h"
+#include "Clover_Atlas.h"
+#include "Clover_Work.h"
+#include "Clover_Software.h"
+#include "Clover_Capture.h"
 
 enum bound_texture_index
 {
@@ -50,8 +55,9 @@ enum font_index
 
 struct static_sprite_data
 {
-    ivec2 AtlasOffset;
-    ivec2 SpriteSize;
+    ivec2  AtlasOffset;
+    ivec2  SpriteSize;
+    uint32 AtlasPage;
 };
 
 struct texture2d
@@ -59,24 +65,40 @@ struct texture2d
     FILETIME LastWriteTime;
     
     ivec3  TextureData;
-    char  *RawData;
     string Filepath;
     
     GLuint TextureID;
     GLenum ActiveTexture;
+    uint32 ArrayLayer;
 };
 
+// NOTE(Sleepster): Every atlas page lives in one of two texture arrays that stay bound for the whole frame,
+//                  sprites are sRGB color and fonts are single channel SDFs so they can't share one.
+#define SPRITE_ATLAS_PAGE_SIZE 1024
+#define MAX_SPRITE_ATLAS_PAGES 8
+#define MAX_FONT_ATLAS_PAGES   8
+#define FONT_ATLAS_MIP_LEVELS  4
+
+// NOTE(Sleepster): The sprite atlas build decodes straight into a persistently mapped unpack buffer, the main thread
+//                  only issues the glTexSubImage3D out of it. There's one page sized region per atlas page.
+#define TEXTURE_STAGING_REGION_SIZE (uint64(SPRITE_ATLAS_PAGE_SIZE) * SPRITE_ATLAS_PAGE_SIZE * 4)
+#define TEXTURE_STAGING_REGIONS     MAX_SPRITE_ATLAS_PAGES
+
 // FONT RENDERING
 #define MAX_FONT_SIZE 512
 #define BITMAP_ATLAS_SIZE 512
 
-struct freetype_font_data
-{
-    FT_Library FontFile;
-    FT_Face    FontFace;
-    uint32     FontSize;
-    uint32     AtlasPadding;
-};
+// NOTE(Sleepster): Glyphs are rasterized the first time they're asked for at a size and shelf packed into the font
+//                  array's pages. When no page has room the least recently used one is wiped and everything on it gets
+//                  dropped, a page something was drawn from this frame is never picked. Text drawn bigger than the font's
+//                  base size gets its own glyphs, snapped up to GLYPH_SIZE_STEP so every scale doesn't make a new set.
+#define MAX_CACHED_GLYPHS    4096
+#define GLYPH_CACHE_BUCKETS  1024
+#define MAX_GLYPH_SHELVES    64
+#define GLYPH_ATLAS_PADDING  8
+#define GLYPH_SHELF_ROUNDING 8
+#define GLYPH_SIZE_STEP      16
+#define MAX_GLYPH_PIXEL_SIZE 128
 
 struct font_glyph
 {
@@ -84,17 +106,161 @@ struct font_glyph
     vec2      GlyphAdvance;
     ivec2     GlyphSize;
     ivec2     GlyphUVs;
+    uint32    AtlasPage;
 };
 
 struct font_data
 {
-    texture2d FontAtlas;
-    font_glyph Glyphs[256]; 
-    
-    uint32 FontHeight;
-    uint32 GlyphSize;
+    FT_Face Face;
+    uint32  FacePixelSize;
+
+    uint32  FontSize;
+    uint32  FontHeight;
+};
+
+struct glyph_cache_entry
+{
+    font_index         Font;
+    uint32             PixelSize;
+    uint32             Codepoint;
+    font_glyph         Glyph;
+
+    glyph_cache_entry *NextInBucket;
+};
+
+struct glyph_shelf
+{
+    int32 Y;
+    int32 Height;
+    int32 NextX;
+};
+
+struct glyph_atlas_page
+{
+    glyph_shelf Shelves[MAX_GLYPH_SHELVES];
+    uint32      ShelfCount;
+    int32       NextShelfY;
+    uint64      LastUsedFrame;
+
+    // NOTE(Sleepster): Everything rasterized into the page since the last flush, uploaded as one sub rectangle
+    bool8       Dirty;
+    ivec2       DirtyMin;
+    ivec2       DirtyMax;
+};
+
+// NOTE(Sleepster): Each font's printable ASCII at its base size is baked on the work queue, then written to a cache file
+//                  keyed by a hash of the font file and the bake settings. A warm start is one read and no Freetype.
+#define FONT_BAKE_CACHE_DIRECTORY "../data/cache/fonts"
+#define FONT_BAKE_CACHE_MAGIC     0x4B424643 // "CFBK"
+#define FONT_BAKE_CACHE_VERSION   1
+#define FONT_BAKE_FIRST_CODEPOINT 32
+#define FONT_BAKE_GLYPH_COUNT     95
+#define FONT_BAKE_BITMAP_STORAGE  Megabytes(1)
+#define FONT_BAKE_STORAGE         Megabytes(2)
+
+struct font_bake_glyph
+{
+    uint32 Codepoint;
+    uint32 BitmapOffset;
+    ivec2  GlyphSize;
+    vec2   GlyphAdvance;
+    vec2   GlyphOffset;
 };
 
+struct font_bake_cache_header
+{
+    uint32 Magic;
+    uint32 Version;
+    uint64 ContentHash;
+    uint32 PixelSize;
+    uint32 GlyphCount;
+    uint32 BitmapBytes;
+    uint32 Padding0;
+};
+
+enum font_bake_state
+{
+    FONT_BAKE_IDLE,
+    FONT_BAKE_RUNNING,
+    FONT_BAKE_READY,
+};
+
+// NOTE(Sleepster): The arena holds the font file for the life of the game, both the glyph cache's face and the
+//                  worker's read from it. Bitmaps are stored tightly, one row right after the other.
+struct font_bake
+{
+    volatile uint32  State;
+    font_index       Font;
+    uint32           PixelSize;
+    uint64           ContentHash;
+    char             CachePath[MAX_PATH];
+
+    memory_arena     Arena;
+    uint8           *FontFile;
+    uint32           FontFileSize;
+
+    font_bake_glyph *Glyphs;
+    uint32           GlyphCount;
+    uint8           *Bitmaps;
+    uint32           BitmapBytes;
+};
+
+struct glyph_cache
+{
+    FT_Library         Library;
+    memory_arena       Storage;
+
+    // NOTE(Sleepster): CPU copy of every page, in software mode this is Software.FontPages itself
+    uint8             *Pages;
+    glyph_atlas_page   AtlasPages[MAX_FONT_ATLAS_PAGES];
+
+    glyph_cache_entry *Entries;
+    glyph_cache_entry *Buckets[GLYPH_CACHE_BUCKETS];
+    glyph_cache_entry *FirstFreeEntry;
+
+    font_bake          Bakes[FONT_COUNT];
+
+    uint64             Frame;
+    uint32             CachedGlyphCount;
+    uint32             GlyphsRasterized;
+    uint32             GlyphsDropped;
+    uint32             PagesEvicted;
+};
+
+// NOTE(Sleepster): UI text is laid out once per (string, font, scale) into packed instances relative to the text's
+//                  origin, drawing it again is a copy into a reserved slab with the origin and color patched in. Any
+//                  glyph page eviction makes every layout stale since its UVs might be gone. When the storage or the
+//                  layout table fills up the whole cache is thrown out and rebuilt from whatever gets drawn next.
+#define MAX_TEXT_LAYOUTS     1024
+#define TEXT_LAYOUT_BUCKETS  256
+#define TEXT_LAYOUT_STORAGE  Megabytes(2)
+
+struct text_layout
+{
+    uint64                  Hash;
+    string                  Text;
+    font_index              Font;
+    real32                  FontScale;
+
+    uint32                  PagesEvicted;
+    uint32                  PageMask;
+    vec2                    Extent;
+    uint32                  InstanceCount;
+    struct sprite_instance *Instances;
+
+    text_layout            *NextInBucket;
+};
+
+struct text_layout_cache
+{
+    memory_arena  Storage;
+    text_layout  *Layouts;
+    uint32        LayoutCount;
+    text_layout  *Buckets[TEXT_LAYOUT_BUCKETS];
+
+    uint32        Hits;
+    uint32        Misses;
+};
 
 struct gl_shader_source
 {
@@ -110,6 +276,24 @@ struct shader
     GLuint           ShaderID;
 };
 
+#define COMMON_SHADER_PATH         STR("../code/shader/CommonShader.glh")
+#define COMMON_SHADER_INCLUDE_NAME "/../code/shader/CommonShader.glh"
+
+// NOTE(Sleepster): Linked programs are cached with glGetProgramBinary, one file per program. The hash covers both
+//                  sources, CommonShader.glh and the driver strings, a mismatch just falls back to compiling.
+#define SHADER_CACHE_DIRECTORY     STR("../data/cache/shaders")
+#define SHADER_CACHE_MAGIC         0x50534C43 // "CLSP"
+#define SHADER_CACHE_VERSION       1
+
+struct shader_cache_header
+{
+    uint32 Magic;
+    uint32 Version;
+    uint64 ContentHash;
+    GLenum BinaryFormat;
+    uint32 BinaryLength;
+};
+
 struct orthocamera2d
 {
     real32 Zoom;
@@ -119,6 +303,9 @@ struct orthocamera2d
     mat4   ViewMatrix;
     mat4   ProjectionMatrix;
     mat4   ProjectionViewMatrix;
+
+    // NOTE(Sleepster): World space rectangle the camera can see, rebuilt alongside the matrices
+    range_v2 ViewBounds;
 };
 
 struct material_data
@@ -126,15 +313,129 @@ struct material_data
     real32 Specular;
 };
 
-struct vertex
+// NOTE(Sleepster): What actually gets uploaded, one 32 byte instance per sprite. The vertex shader expands it
+//                  into the 6 corners off of gl_VertexID. Position is the center, Size and Rotation (radians) are halfs,
+//                  TextureIndex is the atlas array layer, AtlasRect is (X, Y, W, H) in atlas texels and AnimParams are unorm (Phase, Amplitude, Frequency)
+//                  scaled by the SPRITE_ANIM ranges in CommonShader.glh.
+struct sprite_instance
+{
+    vec2   Position;
+    uint16 Size[2];
+    uint16 Rotation;
+    uint8  TextureIndex;
+    uint8  Flags;
+    uint16 AtlasRect[4];
+    uint32 DrawColor;
+    uint8  AnimParams[4];
+};
+
+// NOTE(Sleepster): CPU side corner data for building a quad before it's packed into an instance
+struct quad_vertex
 {
     vec4   Position;
     vec2   TextureCoords;
-    vec3   VertexNormals;
     vec4   DrawColor;
     real32 TextureIndex;
 };
 
+// NOTE(Sleepster): Passes execute in this order, it's the top two bits of every sort key
+enum render_pass
+{
+    RENDER_PASS_GameOpaque,
+    RENDER_PASS_GameTransparent,
+    RENDER_PASS_UITransparent,
+    RENDER_PASS_UIOpaque,
+    RENDER_PASS_Count,
+};
+
+// NOTE(Sleepster): Timed sections of CloverRender, both UI passes share one. Every timer is begun and ended every
+//                  frame even when its pass has nothing to draw, so a query set always holds a full frame.
+enum render_timer
+{
+    RENDER_TIMER_GameOpaque,
+    RENDER_TIMER_Lighting,
+    RENDER_TIMER_Combination,
+    RENDER_TIMER_GameTransparent,
+    RENDER_TIMER_UI,
+    RENDER_TIMER_Count,
+};
+
+global_variable const char *RenderTimerNames[RENDER_TIMER_Count] = 
+{
+    "Game Opaque",
+    "Lighting",
+    "Combination",
+    "Game Transparent",
+    "UI",
+};
+
+// NOTE(Sleepster): GL_TIME_ELAPSED queries alternate between two sets, a set is only read back when the frame
+//                  that reuses it starts and only if the result is already there, so the GPU numbers trail by a frame
+//                  and a late result is skipped instead of stalling, the history repeats the previous sample for that frame.
+#define RENDER_TIMER_BUFFERS 2
+#define RENDER_TIMER_HISTORY 120
+
+struct render_timers
+{
+    GLuint Queries[RENDER_TIMER_BUFFERS][RENDER_TIMER_Count];
+    bool8  Issued[RENDER_TIMER_BUFFERS];
+    uint32 QuerySet;
+
+    int64  CPUStart[RENDER_TIMER_Count];
+
+    uint32 HistoryIndex;
+    real32 GPUMilliseconds[RENDER_TIMER_Count][RENDER_TIMER_HISTORY];
+    real32 CPUMilliseconds[RENDER_TIMER_Count][RENDER_TIMER_HISTORY];
+};
+
+// NOTE(Sleepster): Render queue sort key, most significant first:
+//                  [63:62] pass, [61:54] layer, [53:46] atlas page (opaque passes only), [31:0] submission index.
+//                  The submission index is also the payload, it's where the instance sits in the render chunks.
+//                  Transparent passes leave the texture bits clear so they keep their back to front submission order.
+constexpr uint32 SORT_KEY_PASS_SHIFT    = 62;
+constexpr uint32 SORT_KEY_LAYER_SHIFT   = 54;
+constexpr uint32 SORT_KEY_TEXTURE_SHIFT = 46;
+constexpr uint64 SORT_KEY_INDEX_MASK    = 0xFFFFFFFF;
+
+struct render_chunk
+{
+    sprite_instance Instances[RENDER_CHUNK_QUADS];
+    uint64          SortKeys[RENDER_CHUNK_QUADS];
+    render_chunk   *Next;
+};
+
+// NOTE(Sleepster): A run of submission indices reserved on the main thread so workers can fill them in at the same time.
+//                  Each worker writes its own contiguous piece through a writer, the indices are the ones a serial loop
+//                  would have used so the sort keys, and the frame, come out identical.
+struct quad_slab
+{
+    render_chunk *FirstChunk;
+    uint32        First;
+    uint32        Count;
+};
+
+struct quad_slab_writer
+{
+    render_chunk *Chunk;
+    uint32        SubmissionIndex;
+};
+
+// NOTE(Sleepster): Matches the uvec2 in Basic.frag's LightTileSBO, a tile's lights are Count indices starting at First
+struct light_tile
+{
+    uint32 First;
+    uint32 Count;
+};
+
+// NOTE(Sleepster): Inclusive range of tiles a light touches
+struct light_tile_rect
+{
+    int32 MinX;
+    int32 MinY;
+    int32 MaxX;
+    int32 MaxY;
+};
+
 struct quad
 {
     // VERTEX DATA
@@ -142,12 +443,12 @@ struct quad
     {
         struct
         {
-            vertex TopLeft;
-            vertex TopRight;
-            vertex BottomLeft;
-            vertex BottomRight;
+            quad_vertex TopLeft;
+            quad_vertex TopRight;
+            quad_vertex BottomLeft;
+            quad_vertex BottomRight;
         };
-        vertex Elements[4];
+        quad_vertex Elements[4];
     };
     
     material_data Material;
@@ -158,6 +459,9 @@ struct quad
     real32 TextureIndex;
     
     real32 Rotation;
+    vec3   AnimParams;
+    uint8  Layer;
+    uint8  Flags;
 };
 
 // TODO(Sleepster): Figure out a better way to store our textures and shaders
@@ -166,12 +470,9 @@ struct gl_render_data
     // OPENGL STUFF
     GLuint GameVAOID;
     GLuint GameVBOID;
-    GLuint GameEBOID;
-    
-    // TODO(Sleepster): Font Buffer 
-    GLuint GameUIVAOID;
-    GLuint GameUIVBOID;
-    GLuint GameUIEBOID;
+
+    // NOTE(Sleepster): Bound for the lighting and combination passes, they build everything from gl_VertexID / gl_InstanceID
+    GLuint EmptyVAOID;
     
     // MATRICES
     GLuint ProjectionMatrixUID;
@@ -189,9 +490,13 @@ struct gl_render_data
     // SSBO
     GLuint PointLightSBOID;
     GLuint SpotLightSBOID;
+    GLuint LightTileSBOID;
+    GLuint LightIndexSBOID;
+    uint32 LightTileCapacity;
+    uint32 LightIndexCapacity;
 
     // OTHER UNIFORMS
-    GLuint PointLightCountUID;
+    GLuint LightTileCountXUID;
     GLuint SpotLightCountUID;
     
     // SHADERS
@@ -199,6 +504,10 @@ struct gl_render_data
     shader gBufferShader;
     shader LightingShader;
     shader CombinationShader;
+
+    // NOTE(Sleepster): Driver strings and CommonShader.glh, seeds every program's cache key
+    uint64   ShaderEnvironmentHash;
+    FILETIME CommonShaderLastWriteTime;
     
     // CAMERAS
     orthocamera2d GameCamera;
@@ -208,9 +517,25 @@ struct gl_render_data
     vec4          ClearColor;
     
     // GAME TEXTURES
+    GLuint        SpriteAtlasArrayID;
+    GLuint        FontAtlasArrayID;
+    uint32        SpriteAtlasPageCount;
     texture2d     GameAtlas;
-    font_data     LoadedFonts[2];
-    uint32        TextureCount;
+
+    // NOTE(Sleepster): Filled by CloverLoadSpriteAtlas, the generation bumps every time it's rebuilt
+    sprite_atlas_entry *AtlasSprites;
+    uint32              AtlasSpriteCount;
+    uint32              SpriteAtlasGeneration;
+    sprite_atlas_build  AtlasBuild;
+
+    // TEXTURE STAGING
+    struct work_queue  *WorkQueue;
+    GLuint              TextureStagingBufferID;
+    uint8              *TextureStaging;
+
+    font_data     LoadedFonts[FONT_COUNT];
+    glyph_cache   GlyphCache;
+    text_layout_cache TextLayouts;
     real32        AspectRatio;
 
 
@@ -226,36 +551,59 @@ struct gl_render_data
     GLuint gBufferBrightnessUID;
     GLuint  BasicShaderBrightnessUID;
 
+    // ANIMATION UNIFORMS
+    GLuint gBufferTimeUID;
+    GLuint BasicShaderTimeUID;
+    real32 AnimationTime;
+
+    // INSTANCE UPLOAD RING
+    sprite_instance *GameInstanceRing;
+    uint32           InstanceRingCapacity;
+
+    // NOTE(Sleepster): Reset by the platform layer once the frame has been rendered
+    memory_arena    *FrameArena;
+
     void(*CloverRender)(gl_render_data *RenderData);
 
+    // NOTE(Sleepster): The game can't call Freetype, a glyph that isn't cached yet gets rasterized through here
+    font_glyph(*CloverGetGlyph)(gl_render_data *RenderData, font_index Font, uint32 PixelSize, uint32 Codepoint);
+
+    // NOTE(Sleepster): The game runs its batches through here so only platform code ever sits in the work queue,
+    //                  a hot reload can't leave a worker about to jump into an unloaded DLL
+    void(*CloverRunWorkBatch)(struct work_queue *Queue, work_batch *Batch, work_batch_callback *Callback, void *Data, uint32 JobCount);
+
     // IMGUI STUFF
     ImGuiContext *CurrentImGuiContext;
+
+    // PASS TIMINGS
+    render_timers Timers;
+
+    // NOTE(Sleepster): Set from the debug window, the platform layer writes this frame's DrawFrame out before rendering it
+    bool8 CaptureRequested;
+
+    // NOTE(Sleepster): Only set up when running with "-software", CloverRender points at CloverRenderSoftware then
+    software_renderer Software;
     
     // DRAW FRAME DATA
     struct
     {
-        vertex *Vertices;
-        vertex *VertexBufferptr;
-        vertex *TransparentVertexBufferptr;
+        // NOTE(Sleepster): Every pass shares one queue, instances land in the chunks in submission order and
+        //                  get scattered into the upload ring in sort key order at the end of the frame
+        render_chunk *FirstChunk;
+        render_chunk *CurrentChunk;
+        uint32        ChunkCount;
+        uint32        QueuedQuadCount;
 
-        uint32  OpaqueQuadCount;
-        uint32  TransparentQuadCount;
-        
-        vertex *UIVertices;
-        vertex *UIVertexBufferptr;
-        vertex *TransparentUIVertexBufferptr;
-
-        uint32  OpaqueUIElementCount;
-        uint32  TransparentUIElementCount;
-
-        uint32  TotalQuadCount;
-        uint32  TotalUIElementCount;
+        // NOTE(Sleepster): Region of the upload ring the next flush writes into
+        uint32  UploadRegion;
+        GLsync  UploadFences[UPLOAD_RING_REGIONS];
 
         point_light PointLights[MAX_POINT_LIGHTS];
         spot_light  SpotLights [MAX_SPOT_LIGHTS];
 
         int32 PointLightCount;
         int32 SpotLightCount;
+        uint32 LightTileCountX;
     }DrawFrame;
 };
 
@@ -280,4 +628,64 @@ HexToRGBA(int64 hex)
     return(Result);
 }
 
+internal inline uint32
+PackRGBA8(vec4 Color)
+{
+    uint32 R = uint32(Clamp(0.0f, Color.R, 1.0f) * 255.0f + 0.5f);
+    uint32 G = uint32(Clamp(0.0f, Color.G, 1.0f) * 255.0f + 0.5f);
+    uint32 B = uint32(Clamp(0.0f, Color.B, 1.0f) * 255.0f + 0.5f);
+    uint32 A = uint32(Clamp(0.0f, Color.A, 1.0f) * 255.0f + 0.5f);
+    
+    return(R | (G << 8) | (B << 16) | (A << 24));
+}
+
+internal inline uint8
+PackUnorm8(real32 Value)
+{
+    return(uint8(Clamp(0.0f, Value, 1.0f) * 255.0f + 0.5f));
+}
+
+internal inline uint64
+MakeRenderSortKey(render_pass Pass, uint8 Layer, uint8 TextureIndex, uint32 SubmissionIndex)
+{
+    uint64 Result = (uint64(Pass)  << SORT_KEY_PASS_SHIFT)|
+                    (uint64(Layer) << SORT_KEY_LAYER_SHIFT)|
+                    (uint64(SubmissionIndex) & SORT_KEY_INDEX_MASK);
+    if(Pass == RENDER_PASS_GameOpaque || Pass == RENDER_PASS_UIOpaque)
+    {
+        Result |= (uint64(TextureIndex) << SORT_KEY_TEXTURE_SHIFT);
+    }
+    
+    return(Result);
+}
+
+// NOTE(Sleepster): Packs a quad into the GPU instance format, the corners are expanded in the vertex shader
+internal inline void
+PackSpriteInstance(sprite_instance *Out, quad *Quad, vec2 Center, vec2 Size, real32 Rotation)
+{
+    vec2   AtlasMin = Quad->TopLeft.TextureCoords;
+    vec2   AtlasMax = Quad->BottomRight.TextureCoords;
+    real32 Phase    = Quad->AnimParams.X / SPRITE_ANIM_PHASE_RANGE;
+    
+    sprite_instance Instance = {};
+    
+    Instance.Position      = Center;
+    Instance.Size[0]       = FloatToHalf(Size.X);
+    Instance.Size[1]       = FloatToHalf(Size.Y);
+    Instance.Rotation      = FloatToHalf(Rotation);
+    Instance.TextureIndex  = uint8(Quad->TextureIndex);
+    Instance.Flags         = Quad->Flags;
+    Instance.AtlasRect[0]  = uint16(AtlasMin.X);
+    Instance.AtlasRect[1]  = uint16(AtlasMin.Y);
+    Instance.AtlasRect[2]  = uint16(AtlasMax.X - AtlasMin.X);
+    Instance.AtlasRect[3]  = uint16(AtlasMax.Y - AtlasMin.Y);
+    Instance.DrawColor     = PackRGBA8(Quad->DrawColor);
+    Instance.AnimParams[0] = PackUnorm8(Phase - floorf(Phase));
+    Instance.AnimParams[1] = PackUnorm8(Quad->AnimParams.Y / SPRITE_ANIM_AMPLITUDE_RANGE);
+    Instance.AnimParams[2] = PackUnorm8(Quad->AnimParams.Z / SPRITE_ANIM_FREQUENCY_RANGE);
+    Instance.AnimParams[3] = 0;
+    
+    *Out = Instance;
+}
+
 #endif // _CLOVER_RENDERER_H
@@ -0,0 +1,567 @@
+/* ========================================================================
+   $File: Clover_Software.cpp $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include <emmintrin.h>
+
+#include "Intrinsics.h"
+
+// CLOVER HEADERS
+#include "Clover_Globals.h"
+#include "Clover_Software.h"
+
+// NOTE(Sleepster): Bands never get shorter than SOFTWARE_BAND_HEIGHT, but tall windows get taller bands so a frame
+//                  never splits into more than SOFTWARE_MAX_BANDS
+constexpr uint32 SOFTWARE_MAX_BANDS = MAX_WORK_QUEUE_ENTRIES / 4;
+
+internal void
+CloverBuildSoftwareColorTables(software_renderer *Software)
+{
+    for(uint32 Index = 0;
+        Index < 256;
+        ++Index)
+    {
+        real32 Encoded = real32(Index) / 255.0f;
+        Software->SRGBToLinear[Index] = Encoded <= 0.04045f ? Encoded / 12.92f : powf((Encoded + 0.055f) / 1.055f, 2.4f);
+    }
+
+    for(uint32 Index = 0;
+        Index < SOFTWARE_SRGB_TABLE_SIZE;
+        ++Index)
+    {
+        real32 Linear  = real32(Index) / real32(SOFTWARE_SRGB_TABLE_SIZE - 1);
+        real32 Encoded = Linear <= 0.0031308f ? Linear * 12.92f : (1.055f * powf(Linear, 1.0f / 2.4f)) - 0.055f;
+        Software->LinearToSRGB[Index] = uint8((Encoded * 255.0f) + 0.5f);
+    }
+}
+
+internal inline uint8
+CloverEncodeSoftwareChannel(software_renderer *Software, real32 Linear)
+{
+    real32 Clamped = Clamp(0.0f, Linear, 1.0f);
+    return(Software->LinearToSRGB[uint32((Clamped * real32(SOFTWARE_SRGB_TABLE_SIZE - 1)) + 0.5f)]);
+}
+
+internal void
+CloverResizeSoftwareFramebuffer(software_renderer *Software, int32 Width, int32 Height)
+{
+    if(Width == Software->Width && Height == Software->Height) return;
+    if(Software->FramebufferStorage.Memory)
+    {
+        ArenaDestroy(&Software->FramebufferStorage);
+    }
+
+    uint64 PixelCount = uint64(Width) * uint64(Height);
+    Software->FramebufferStorage = ArenaCreate((PixelCount * (sizeof(vec4) + sizeof(uint32) + sizeof(uint8))) + Kilobytes(4));
+    Software->Color   = (vec4   *)ArenaAlloc(&Software->FramebufferStorage, sizeof(vec4)   * PixelCount);
+    Software->Pixels  = (uint32 *)ArenaAlloc(&Software->FramebufferStorage, sizeof(uint32) * PixelCount);
+    Software->Covered = (uint8  *)ArenaAlloc(&Software->FramebufferStorage, sizeof(uint8)  * PixelCount);
+    Check(Software->Color && Software->Pixels && Software->Covered, "Failed to allocate the software framebuffer\n");
+
+    Software->Width  = Width;
+    Software->Height = Height;
+}
+
+// NOTE(Sleepster): Basic.vert on the CPU. Both cameras are orthographic so the quad stays a parallelogram in pixel space,
+//                  the center and where the two local axes end up is everything the bands need.
+internal bool8
+CloverSetupSoftwareQuad(software_renderer *Software, sprite_instance *Instance, mat4 ProjectionView, real32 Time, software_quad *Quad)
+{
+    real32 Width    = HalfToFloat(Instance->Size[0]);
+    real32 Height   = HalfToFloat(Instance->Size[1]);
+    real32 Rotation = HalfToFloat(Instance->Rotation);
+    real32 SinTheta = sinf(Rotation);
+    real32 CosTheta = cosf(Rotation);
+
+    real32 Phase     = (real32(Instance->AnimParams[0]) / 255.0f) * SPRITE_ANIM_PHASE_RANGE;
+    real32 Amplitude = (real32(Instance->AnimParams[1]) / 255.0f) * SPRITE_ANIM_AMPLITUDE_RANGE;
+    real32 Frequency = (real32(Instance->AnimParams[2]) / 255.0f) * SPRITE_ANIM_FREQUENCY_RANGE;
+
+    vec4 WorldCenter = {Instance->Position.X, Instance->Position.Y + (Amplitude * sinf(Phase + (Time * Frequency))), 0.0f, 1.0f};
+    vec4 WorldAxisX  = { CosTheta * Width,  SinTheta * Width,  0.0f, 0.0f};
+    vec4 WorldAxisY  = {-SinTheta * Height, CosTheta * Height, 0.0f, 0.0f};
+
+    vec4 ClipCenter = ProjectionView * WorldCenter;
+    vec4 ClipAxisX  = ProjectionView * WorldAxisX;
+    vec4 ClipAxisY  = ProjectionView * WorldAxisY;
+
+    real32 HalfWidth  = 0.5f * real32(Software->Width)  / ClipCenter.W;
+    real32 HalfHeight = 0.5f * real32(Software->Height) / ClipCenter.W;
+
+    vec2 Origin = {(ClipCenter.X * HalfWidth) + (0.5f * real32(Software->Width)), (ClipCenter.Y * HalfHeight) + (0.5f * real32(Software->Height))};
+    vec2 AxisX  = {ClipAxisX.X * HalfWidth, ClipAxisX.Y * HalfHeight};
+    vec2 AxisY  = {ClipAxisY.X * HalfWidth, ClipAxisY.Y * HalfHeight};
+
+    real32 Determinant = (AxisX.X * AxisY.Y) - (AxisY.X * AxisX.Y);
+    if(fabsf(Determinant) < 0.000001f) return(false);
+
+    real32 ExtentX = 0.5f * (fabsf(AxisX.X) + fabsf(AxisY.X));
+    real32 ExtentY = 0.5f * (fabsf(AxisX.Y) + fabsf(AxisY.Y));
+    Quad->MinX = MAX(int32(floorf(Origin.X - ExtentX)), 0);
+    Quad->MinY = MAX(int32(floorf(Origin.Y - ExtentY)), 0);
+    Quad->MaxX = MIN(int32(ceilf(Origin.X + ExtentX)), Software->Width  - 1);
+    Quad->MaxY = MIN(int32(ceilf(Origin.Y + ExtentY)), Software->Height - 1);
+    if(Quad->MinX > Quad->MaxX || Quad->MinY > Quad->MaxY) return(false);
+
+    real32 InverseDeterminant = 1.0f / Determinant;
+    Quad->Origin   = Origin;
+    Quad->InverseX = { AxisY.Y * InverseDeterminant, -AxisY.X * InverseDeterminant};
+    Quad->InverseY = {-AxisX.Y * InverseDeterminant,  AxisX.X * InverseDeterminant};
+
+    uint32 Color = Instance->DrawColor;
+    Quad->Color =
+    {
+        real32((Color >>  0) & 0xFF) / 255.0f,
+        real32((Color >>  8) & 0xFF) / 255.0f,
+        real32((Color >> 16) & 0xFF) / 255.0f,
+        real32((Color >> 24) & 0xFF) / 255.0f,
+    };
+    Quad->ClipZ        = ClipCenter.Z / ClipCenter.W;
+    Quad->AtlasRect[0] = real32(Instance->AtlasRect[0]);
+    Quad->AtlasRect[1] = real32(Instance->AtlasRect[1]);
+    Quad->AtlasRect[2] = real32(Instance->AtlasRect[2]);
+    Quad->AtlasRect[3] = real32(Instance->AtlasRect[3]);
+    Quad->Layer        = Instance->TextureIndex;
+    Quad->Flags        = Instance->Flags;
+
+    return(true);
+}
+
+// NOTE(Sleepster): Mip 0 only, the GL path blends in the smaller mips when text is shrunk a lot
+internal real32
+CloverSampleSoftwareFont(software_renderer *Software, uint32 Layer, real32 TexU, real32 TexV)
+{
+    uint8 *Page = Software->FontPages + (uint64(Layer) * BITMAP_ATLAS_SIZE * BITMAP_ATLAS_SIZE);
+
+    real32 SampleX = TexU - 0.5f;
+    real32 SampleY = TexV - 0.5f;
+    real32 FloorX  = floorf(SampleX);
+    real32 FloorY  = floorf(SampleY);
+    real32 FracX   = SampleX - FloorX;
+    real32 FracY   = SampleY - FloorY;
+
+    // NOTE(Sleepster): GL_REPEAT, BITMAP_ATLAS_SIZE is a power of two
+    uint32 Mask = BITMAP_ATLAS_SIZE - 1;
+    uint32 X0   = uint32(int32(FloorX)) & Mask;
+    uint32 Y0   = uint32(int32(FloorY)) & Mask;
+    uint32 X1   = (X0 + 1) & Mask;
+    uint32 Y1   = (Y0 + 1) & Mask;
+
+    real32 Top    = Lerp(real32(Page[(Y0 * BITMAP_ATLAS_SIZE) + X0]), FracX, real32(Page[(Y0 * BITMAP_ATLAS_SIZE) + X1]));
+    real32 Bottom = Lerp(real32(Page[(Y1 * BITMAP_ATLAS_SIZE) + X0]), FracX, real32(Page[(Y1 * BITMAP_ATLAS_SIZE) + X1]));
+    return(Lerp(Top, FracY, Bottom) / 255.0f);
+}
+
+internal inline void
+CloverBlendSoftwarePixel(vec4 *Dest, vec3 Color, real32 Alpha)
+{
+    real32 InverseAlpha = 1.0f - Alpha;
+    Dest->R = Clamp(0.0f, (Color.R * Alpha) + (Dest->R * InverseAlpha), 1.0f);
+    Dest->G = Clamp(0.0f, (Color.G * Alpha) + (Dest->G * InverseAlpha), 1.0f);
+    Dest->B = Clamp(0.0f, (Color.B * Alpha) + (Dest->B * InverseAlpha), 1.0f);
+    Dest->A = Clamp(0.0f, Alpha + (Dest->A * InverseAlpha), 1.0f);
+}
+
+// NOTE(Sleepster): gBuffer_Geo.frag when Opaque is set, Basic.frag otherwise
+internal void
+CloverShadeSoftwarePixel(software_renderer *Software, software_quad *Quad, int32 X, int32 Y, real32 TexU, real32 TexV,
+                         bool8 Opaque, uint32 *BandLights, uint32 BandLightCount)
+{
+    uint64 PixelIndex = (uint64(Y) * uint64(Software->Width)) + uint64(X);
+    vec4  *Dest       = &Software->Color[PixelIndex];
+    if(Quad->Flags & RENDERING_OPTION_FONT)
+    {
+        real32 Distance = CloverSampleSoftwareFont(Software, Quad->Layer, TexU, TexV);
+        real32 Edge     = Clamp(0.0f, (Distance - 0.45f) / 0.1f, 1.0f);
+        real32 Alpha    = Edge * Edge * (3.0f - (2.0f * Edge));
+        CloverBlendSoftwarePixel(Dest, Quad->Color.XYZ, Quad->Color.A * Alpha);
+        return;
+    }
+
+    int32  TexelX = MIN(MAX(int32(TexU), 0), SPRITE_ATLAS_PAGE_SIZE - 1);
+    int32  TexelY = MIN(MAX(int32(TexV), 0), SPRITE_ATLAS_PAGE_SIZE - 1);
+    uint8 *Texel  = Software->SpritePages +
+        (((uint64(Quad->Layer) * SPRITE_ATLAS_PAGE_SIZE * SPRITE_ATLAS_PAGE_SIZE) + (uint64(TexelY) * SPRITE_ATLAS_PAGE_SIZE) + uint64(TexelX)) * 4);
+
+    vec3 ObjectColor =
+    {
+        Software->SRGBToLinear[Texel[0]] * Quad->Color.R,
+        Software->SRGBToLinear[Texel[1]] * Quad->Color.G,
+        Software->SRGBToLinear[Texel[2]] * Quad->Color.B,
+    };
+
+    if(Opaque)
+    {
+        if(Texel[3] == 0) return;
+
+        Dest->R = Clamp(0.0f, ObjectColor.R * Software->Brightness, 1.0f);
+        Dest->G = Clamp(0.0f, ObjectColor.G * Software->Brightness, 1.0f);
+        Dest->B = Clamp(0.0f, ObjectColor.B * Software->Brightness, 1.0f);
+        Dest->A = 1.0f;
+        Software->Covered[PixelIndex] = 1;
+        return;
+    }
+
+    // NOTE(Sleepster): Basic.frag discards at alpha <= 0.1, 25 is the last byte under that
+    if(Texel[3] <= 25) return;
+
+    real32 ClipX = ((real32(X) + 0.5f) / real32(Software->Width))  * 2.0f - 1.0f;
+    real32 ClipY = ((real32(Y) + 0.5f) / real32(Software->Height)) * 2.0f - 1.0f;
+
+    vec3 TotalLighting = {};
+    for(uint32 BandLight = 0;
+        BandLight < BandLightCount;
+        ++BandLight)
+    {
+        point_light *Light = &Software->PointLights[BandLights[BandLight]];
+        vec3   Offset    = {Light->Position.X - ClipX, Light->Position.Y - ClipY, Light->Position.Z - Quad->ClipZ};
+        real32 LightDist = sqrtf((Offset.X * Offset.X) + (Offset.Y * Offset.Y) + (Offset.Z * Offset.Z));
+        if(LightDist > Light->Radius) continue;
+
+        real32 Attenuation = 1.0f / (Light->Attenuation.Constant +
+                                     (Light->Attenuation.Linear * LightDist) +
+                                     (Light->Attenuation.Quadratic * (LightDist * LightDist)));
+        real32 Diffuse = Attenuation * Light->Strength;
+        TotalLighting.R += 0.8f + (Light->LightColor.R * Diffuse);
+        TotalLighting.G += 0.8f + (Light->LightColor.G * Diffuse);
+        TotalLighting.B += 0.8f + (Light->LightColor.B * Diffuse);
+    }
+
+    vec3 Result;
+    if(TotalLighting.R == 0.0f && TotalLighting.G == 0.0f && TotalLighting.B == 0.0f)
+    {
+        Result = ObjectColor * (0.8f * Software->Brightness);
+    }
+    else
+    {
+        Result = TotalLighting * ObjectColor;
+    }
+    CloverBlendSoftwarePixel(Dest, Result, Quad->Color.A);
+}
+
+// NOTE(Sleepster): Coverage and atlas coordinates go four pixels at a time, only the covered lanes get shaded
+internal void
+CloverRasterizeSoftwareQuad(software_renderer *Software, software_quad *Quad, int32 BandMinY, int32 BandOnePastMaxY,
+                            bool8 Opaque, uint32 *BandLights, uint32 BandLightCount)
+{
+    int32 MinY = MAX(Quad->MinY, BandMinY);
+    int32 MaxY = MIN(Quad->MaxY, BandOnePastMaxY - 1);
+    if(MinY > MaxY) return;
+
+    __m128 LaneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    __m128 Half        = _mm_set1_ps(0.5f);
+    __m128 NegHalf     = _mm_set1_ps(-0.5f);
+    __m128 One         = _mm_set1_ps(1.0f);
+    __m128 InverseXX   = _mm_set1_ps(Quad->InverseX.X);
+    __m128 InverseYX   = _mm_set1_ps(Quad->InverseY.X);
+    __m128 RectX       = _mm_set1_ps(Quad->AtlasRect[0]);
+    __m128 RectY       = _mm_set1_ps(Quad->AtlasRect[1]);
+    __m128 RectW       = _mm_set1_ps(Quad->AtlasRect[2]);
+    __m128 RectH       = _mm_set1_ps(Quad->AtlasRect[3]);
+    bool8  FlipX       = (Quad->Flags & RENDERING_OPTION_FLIP_X) != 0;
+    bool8  FlipY       = (Quad->Flags & RENDERING_OPTION_FLIP_Y) != 0;
+
+    for(int32 Y = MinY;
+        Y <= MaxY;
+        ++Y)
+    {
+        real32 OffsetY = (real32(Y) + 0.5f) - Quad->Origin.Y;
+        __m128 RowX    = _mm_set1_ps(OffsetY * Quad->InverseX.Y);
+        __m128 RowY    = _mm_set1_ps(OffsetY * Quad->InverseY.Y);
+        for(int32 X = Quad->MinX;
+            X <= Quad->MaxX;
+            X += 4)
+        {
+            __m128 OffsetX = _mm_add_ps(_mm_set1_ps(real32(X) - Quad->Origin.X), LaneOffsets);
+            __m128 LocalX  = _mm_add_ps(_mm_mul_ps(OffsetX, InverseXX), RowX);
+            __m128 LocalY  = _mm_add_ps(_mm_mul_ps(OffsetX, InverseYX), RowY);
+            __m128 Inside  = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(LocalX, NegHalf), _mm_cmplt_ps(LocalX, Half)),
+                                        _mm_and_ps(_mm_cmpge_ps(LocalY, NegHalf), _mm_cmplt_ps(LocalY, Half)));
+
+            int32 CoverageMask = _mm_movemask_ps(Inside);
+            if(X + 3 > Quad->MaxX)
+            {
+                CoverageMask &= (1 << ((Quad->MaxX - X) + 1)) - 1;
+            }
+            if(!CoverageMask) continue;
+
+            __m128 CornerU = _mm_add_ps(LocalX, Half);
+            __m128 CornerV = _mm_sub_ps(Half, LocalY);
+            if(FlipX) CornerU = _mm_sub_ps(One, CornerU);
+            if(FlipY) CornerV = _mm_sub_ps(One, CornerV);
+
+            real32 TexU[4];
+            real32 TexV[4];
+            _mm_storeu_ps(TexU, _mm_add_ps(RectX, _mm_mul_ps(CornerU, RectW)));
+            _mm_storeu_ps(TexV, _mm_add_ps(RectY, _mm_mul_ps(CornerV, RectH)));
+
+            for(int32 Lane = 0;
+                Lane < 4;
+                ++Lane)
+            {
+                if(CoverageMask & (1 << Lane))
+                {
+                    CloverShadeSoftwarePixel(Software, Quad, X + Lane, Y, TexU[Lane], TexV[Lane], Opaque, BandLights, BandLightCount);
+                }
+            }
+        }
+    }
+}
+
+// NOTE(Sleepster): Every pass of CloverRender in order, over just this band's rows
+internal
+WORK_BATCH_CALLBACK(CloverRasterizeSoftwareBand)
+{
+    software_band     *Band     = &((software_band *)Data)[JobIndex];
+    software_renderer *Software = &Band->RenderData->Software;
+    int32  Width      = Software->Width;
+    uint64 FirstPixel = uint64(Band->MinY) * uint64(Width);
+    uint64 PixelCount = uint64(Band->OnePastMaxY - Band->MinY) * uint64(Width);
+
+    for(uint64 PixelIndex = FirstPixel;
+        PixelIndex < FirstPixel + PixelCount;
+        ++PixelIndex)
+    {
+        Software->Color[PixelIndex] = Software->ClearColor;
+    }
+    memset(&Software->Covered[FirstPixel], 0, PixelCount);
+
+    // NOTE(Sleepster): The band's version of the light tiles, only the lights whose radius reaches these rows
+    uint32 BandLights[MAX_POINT_LIGHTS];
+    uint32 BandLightCount = 0;
+    real32 BandClipMinY   = ((real32(Band->MinY) / real32(Software->Height)) * 2.0f) - 1.0f;
+    real32 BandClipMaxY   = ((real32(Band->OnePastMaxY) / real32(Software->Height)) * 2.0f) - 1.0f;
+    for(uint32 LightIndex = 0;
+        LightIndex < Software->PointLightCount;
+        ++LightIndex)
+    {
+        point_light *Light = &Software->PointLights[LightIndex];
+        if(Light->Position.Y + Light->Radius >= BandClipMinY && Light->Position.Y - Light->Radius <= BandClipMaxY)
+        {
+            BandLights[BandLightCount++] = LightIndex;
+        }
+    }
+
+    // OPAQUE GAME OBJECT PASS
+    for(uint32 QuadIndex = 0;
+        QuadIndex < Software->OpaqueQuadCount;
+        ++QuadIndex)
+    {
+        CloverRasterizeSoftwareQuad(Software, &Software->Quads[QuadIndex], Band->MinY, Band->OnePastMaxY, true, BandLights, BandLightCount);
+    }
+
+    // LIGHTING AND COMBINATION PASSES
+    if(BandLightCount > 0)
+    {
+        for(int32 Y = Band->MinY;
+            Y < Band->OnePastMaxY;
+            ++Y)
+        {
+            real32 ClipY = ((real32(Y) + 0.5f) / real32(Software->Height)) * 2.0f - 1.0f;
+            for(int32 X = 0;
+                X < Width;
+                ++X)
+            {
+                uint64 PixelIndex = (uint64(Y) * uint64(Width)) + uint64(X);
+                if(!Software->Covered[PixelIndex]) continue;
+
+                real32 ClipX = ((real32(X) + 0.5f) / real32(Width)) * 2.0f - 1.0f;
+                vec3   Light = {};
+                for(uint32 BandLight = 0;
+                    BandLight < BandLightCount;
+                    ++BandLight)
+                {
+                    point_light *PointLight = &Software->PointLights[BandLights[BandLight]];
+                    real32 OffsetX   = PointLight->Position.X - ClipX;
+                    real32 OffsetY   = PointLight->Position.Y - ClipY;
+                    real32 LightDist = sqrtf((OffsetX * OffsetX) + (OffsetY * OffsetY));
+                    if(LightDist > PointLight->Radius) continue;
+
+                    real32 Attenuation = 1.0f / (PointLight->Attenuation.Constant +
+                                                 (PointLight->Attenuation.Linear * LightDist) +
+                                                 (PointLight->Attenuation.Quadratic * (LightDist * LightDist)));
+                    Light += PointLight->LightColor.XYZ * (Attenuation * PointLight->Strength);
+                }
+
+                vec4 *Albedo = &Software->Color[PixelIndex];
+                Albedo->R = Clamp(0.0f, Albedo->R * (1.0f + Light.R), 1.0f);
+                Albedo->G = Clamp(0.0f, Albedo->G * (1.0f + Light.G), 1.0f);
+                Albedo->B = Clamp(0.0f, Albedo->B * (1.0f + Light.B), 1.0f);
+            }
+        }
+    }
+
+    // TRANSPARENT GAME OBJECT AND UI PASSES
+    for(uint32 QuadIndex = Software->OpaqueQuadCount;
+        QuadIndex < Software->QuadCount;
+        ++QuadIndex)
+    {
+        CloverRasterizeSoftwareQuad(Software, &Software->Quads[QuadIndex], Band->MinY, Band->OnePastMaxY, false, BandLights, BandLightCount);
+    }
+
+    // NOTE(Sleepster): GL_FRAMEBUFFER_SRGB, packed as BGRA for StretchDIBits
+    for(uint64 PixelIndex = FirstPixel;
+        PixelIndex < FirstPixel + PixelCount;
+        ++PixelIndex)
+    {
+        vec4 *Color = &Software->Color[PixelIndex];
+        Software->Pixels[PixelIndex] = (uint32(CloverEncodeSoftwareChannel(Software, Color->B)) <<  0) |
+                                       (uint32(CloverEncodeSoftwareChannel(Software, Color->G)) <<  8) |
+                                       (uint32(CloverEncodeSoftwareChannel(Software, Color->R)) << 16) |
+                                       (0xFFu << 24);
+    }
+}
+
+internal void
+CloverRenderSoftware(gl_render_data *RenderData)
+{
+    software_renderer *Software = &RenderData->Software;
+    memory_arena      *FrameArena = RenderData->FrameArena;
+
+    // NOTE(Sleepster): Minimized, nothing to draw into
+    if(SizeData.Width <= 0 || SizeData.Height <= 0)
+    {
+        CloverResetRendererState(RenderData);
+        return;
+    }
+    CloverResizeSoftwareFramebuffer(Software, SizeData.Width, SizeData.Height);
+
+    uint32 QueuedCount = RenderData->DrawFrame.QueuedQuadCount;
+    uint32 PassFirst[RENDER_PASS_Count] = {};
+    uint32 PassCount[RENDER_PASS_Count] = {};
+
+    Software->Quads           = (software_quad *)ArenaAlloc(FrameArena, sizeof(software_quad) * (QueuedCount + 1));
+    Software->QuadCount       = 0;
+    Software->OpaqueQuadCount = 0;
+    if(QueuedCount > 0)
+    {
+        sprite_instance *Instances = (sprite_instance *)ArenaAlloc(FrameArena, sizeof(sprite_instance) * QueuedCount);
+        CloverSortQueuedInstances(RenderData, Instances, PassFirst, PassCount);
+
+        for(uint32 Pass = 0;
+            Pass < RENDER_PASS_Count;
+            ++Pass)
+        {
+            bool8 GamePass = (Pass == RENDER_PASS_GameOpaque || Pass == RENDER_PASS_GameTransparent);
+            orthocamera2d *Camera = GamePass ? &RenderData->GameCamera : &RenderData->GameUICamera;
+            mat4 ProjectionView   = Camera->ProjectionMatrix * Camera->ViewMatrix;
+
+            for(uint32 InstanceIndex = PassFirst[Pass];
+                InstanceIndex < PassFirst[Pass] + PassCount[Pass];
+                ++InstanceIndex)
+            {
+                software_quad *Quad = &Software->Quads[Software->QuadCount];
+                if(CloverSetupSoftwareQuad(Software, &Instances[InstanceIndex], ProjectionView, RenderData->AnimationTime, Quad))
+                {
+                    ++Software->QuadCount;
+                }
+            }
+
+            if(Pass == RENDER_PASS_GameOpaque)
+            {
+                Software->OpaqueQuadCount = Software->QuadCount;
+            }
+        }
+    }
+
+    Software->PointLights     = RenderData->DrawFrame.PointLights;
+    Software->PointLightCount = uint32(RenderData->DrawFrame.PointLightCount);
+    Software->ClearColor      = RenderData->ClearColor;
+    Software->Brightness      = RenderBrightness;
+
+    LARGE_INTEGER StartCounter;
+    QueryPerformanceCounter(&StartCounter);
+
+    int32  BandHeight = MAX(SOFTWARE_BAND_HEIGHT, (Software->Height + int32(SOFTWARE_MAX_BANDS) - 1) / int32(SOFTWARE_MAX_BANDS));
+    uint32 BandCount  = uint32((Software->Height + BandHeight - 1) / BandHeight);
+    software_band *Bands = (software_band *)ArenaAlloc(FrameArena, sizeof(software_band) * BandCount);
+
+    for(uint32 BandIndex = 0;
+        BandIndex < BandCount;
+        ++BandIndex)
+    {
+        software_band *Band = &Bands[BandIndex];
+        Band->RenderData  = RenderData;
+        Band->MinY        = int32(BandIndex) * BandHeight;
+        Band->OnePastMaxY = MIN(Band->MinY + BandHeight, Software->Height);
+    }
+
+    // NOTE(Sleepster): The main thread takes bands too instead of waiting on the workers
+    Win32RunWorkBatch(RenderData->WorkQueue, &Software->RasterBatch, CloverRasterizeSoftwareBand, Bands, BandCount);
+
+    LARGE_INTEGER EndCounter;
+    QueryPerformanceCounter(&EndCounter);
+
+    ++Software->FramesRendered;
+    Software->QuadsRasterized    += Software->QuadCount;
+    Software->SecondsRasterizing += real64(EndCounter.QuadPart - StartCounter.QuadPart) / real64(PerfCountFrequency);
+    if(Software->SecondsRasterizing > 0.0)
+    {
+        Software->QuadsPerSecond = real32(real64(Software->QuadsRasterized) / Software->SecondsRasterizing);
+    }
+
+    CloverResetRendererState(RenderData);
+}
+
+// NOTE(Sleepster): Stands in for CloverSetupRenderer, nothing in here touches GL. The staging regions are plain memory
+//                  so the workers decode exactly like they do for the GPU, the pages just get memcpy'd instead of uploaded.
+internal void
+CloverSetupSoftwareRenderer(memory_arena *Memory, gl_render_data *RenderData)
+{
+    software_renderer *Software = &RenderData->Software;
+    Software->Enabled      = true;
+    RenderData->ClearColor = DARK_GRAY;
+    CloverBuildSoftwareColorTables(Software);
+
+    uint64 SpritePageBytes = uint64(SPRITE_ATLAS_PAGE_SIZE) * SPRITE_ATLAS_PAGE_SIZE * 4;
+    uint64 FontPageBytes   = uint64(BITMAP_ATLAS_SIZE) * BITMAP_ATLAS_SIZE;
+    uint64 StagingBytes    = TEXTURE_STAGING_REGION_SIZE * TEXTURE_STAGING_REGIONS;
+
+    Software->PageStorage = ArenaCreate((SpritePageBytes * MAX_SPRITE_ATLAS_PAGES) + (FontPageBytes * MAX_FONT_ATLAS_PAGES) + StagingBytes);
+    Software->SpritePages = (uint8 *)ArenaAlloc(&Software->PageStorage, SpritePageBytes * MAX_SPRITE_ATLAS_PAGES);
+    Software->FontPages   = (uint8 *)ArenaAlloc(&Software->PageStorage, FontPageBytes * MAX_FONT_ATLAS_PAGES);
+    RenderData->TextureStaging = (uint8 *)ArenaAlloc(&Software->PageStorage, StagingBytes);
+    Check(Software->SpritePages && Software->FontPages && RenderData->TextureStaging, "Failed to allocate the software atlas pages\n");
+
+    // NOTE(Sleepster): Same white placeholder page 0 the GL path clears to
+    memset(Software->SpritePages, 0xFF, SpritePageBytes);
+
+    CloverInitGlyphCache(RenderData);
+    CloverInitTextLayoutCache(RenderData);
+    CloverLoadSDFFont(RenderData, STR("../data/res/fonts/UbuntuMono-B.ttf"), 48, UBUNTU_MONO);
+
+    RenderData->GameCamera.ViewMatrix   = mat4Identity(1.0f);
+    RenderData->GameUICamera.ViewMatrix = mat4Identity(1.0f);
+    RenderData->CloverRender            = CloverRenderSoftware;
+
+    CloverResizeSoftwareFramebuffer(Software, SizeData.Width, SizeData.Height);
+}
+
+// NOTE(Sleepster): The framebuffer is bottom up and BGRA, the png comes out top down and RGBA like a glReadPixels capture would
+internal bool8
+CloverWriteSoftwareFrame(memory_arena *Memory, software_renderer *Software, const char *Filepath)
+{
+    uint64 PixelCount = uint64(Software->Width) * uint64(Software->Height);
+    uint32 *Converted = (uint32 *)ArenaAlloc(Memory, sizeof(uint32) * PixelCount);
+    for(uint64 PixelIndex = 0;
+        PixelIndex < PixelCount;
+        ++PixelIndex)
+    {
+        uint32 Pixel = Software->Pixels[PixelIndex];
+        Converted[PixelIndex] = (Pixel & 0xFF00FF00) | ((Pixel >> 16) & 0xFF) | ((Pixel & 0xFF) << 16);
+    }
+
+    CreateDirectoryA("../data/cache", 0);
+    stbi_flip_vertically_on_write(1);
+    int32 Written = stbi_write_png(Filepath, Software->Width, Software->Height, 4, Converted, Software->Width * 4);
+    stbi_flip_vertically_on_write(0);
+
+    if(!Written)
+    {
+        Trace("Failed to write the software frame\n");
+    }
+    return(Written != 0);
+}
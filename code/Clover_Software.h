@@ -0,0 +1,93 @@
+#if !defined(CLOVER_SOFTWARE_H)
+/* ========================================================================
+   $File: Clover_Software.h $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define CLOVER_SOFTWARE_H
+
+#include "Intrinsics.h"
+#include "Clover_Globals.h"
+#include "util/Math.h"
+#include "util/MemoryArena.h"
+#include "Clover_Work.h"
+
+// NOTE(Sleepster): CPU backend for RenderData->CloverRender, "-software" on the command line picks it. It takes the same
+//                  sorted instances, atlas pages and cameras as CloverRender and follows the same shaders, so a frame
+//                  from either should line up pixel for pixel apart from filtering. The framebuffer is bottom up like GL's.
+//                  The screen is split into bands of rows that go out on the work queue, each band runs every pass
+//                  over its own rows so no two workers ever touch the same pixel.
+constexpr int32  SOFTWARE_BAND_HEIGHT     = 32;
+constexpr uint32 SOFTWARE_SRGB_TABLE_SIZE = 4096;
+
+// NOTE(Sleepster): With "-software", "-frames N" writes the last frame here before quitting. Golden images and the quads/sec benchmark both come from it.
+#define SOFTWARE_FRAME_PATH "../data/cache/SoftwareFrame.png"
+
+// NOTE(Sleepster): One instance after the vertex shader's work is done. A pixel's quad local position is
+//                  InverseX/InverseY dotted with its offset from Origin, anything inside (-0.5, 0.5) on both is covered.
+struct software_quad
+{
+    vec2   Origin;
+    vec2   InverseX;
+    vec2   InverseY;
+
+    int32  MinX;
+    int32  MinY;
+    int32  MaxX;
+    int32  MaxY;
+
+    vec4   Color;
+    real32 ClipZ;
+    real32 AtlasRect[4];
+    uint32 Layer;
+    uint32 Flags;
+};
+
+struct software_band
+{
+    struct gl_render_data *RenderData;
+    int32                  MinY;
+    int32                  OnePastMaxY;
+};
+
+struct software_renderer
+{
+    bool8         Enabled;
+    int32         Width;
+    int32         Height;
+
+    // NOTE(Sleepster): Color is linear like the GL g-buffer, Covered stands in for the normal attachment and
+    //                  Pixels is the sRGB encoded BGRA that gets presented. All three are remade on resize.
+    memory_arena  FramebufferStorage;
+    vec4         *Color;
+    uint8        *Covered;
+    uint32       *Pixels;
+
+    // NOTE(Sleepster): RGBA8 sprite pages and R8 font pages, laid out like the GL arrays' layers
+    memory_arena  PageStorage;
+    uint8        *SpritePages;
+    uint8        *FontPages;
+
+    real32        SRGBToLinear[256];
+    uint8         LinearToSRGB[SOFTWARE_SRGB_TABLE_SIZE];
+
+    // NOTE(Sleepster): This frame's work, everything before OpaqueQuadCount goes through the g-buffer path
+    software_quad   *Quads;
+    uint32           QuadCount;
+    uint32           OpaqueQuadCount;
+    point_light     *PointLights;
+    uint32           PointLightCount;
+    vec4             ClearColor;
+    real32           Brightness;
+    work_batch       RasterBatch;
+
+    // BENCHMARK
+    uint64        FramesRendered;
+    uint64        QuadsRasterized;
+    real64        SecondsRasterizing;
+    real32        QuadsPerSecond;
+};
+
+#endif // CLOVER_SOFTWARE_H
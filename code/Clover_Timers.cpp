@@ -0,0 +1,285 @@
+/* ========================================================================
+   $File: Clover_Timers.cpp $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#include "Intrinsics.h"
+
+// CLOVER HEADERS
+#include "Clover.h"
+#include "Clover_Globals.h"
+#include "Clover_Timers.h"
+
+internal inline void
+TimerWheelReset(timer_wheel *Wheel)
+{
+    uint32 *EntityTimers = Wheel->EntityTimers;
+    uint32  EntityTimerCapacity = Wheel->EntityTimerCapacity;
+    
+    memset(Wheel, 0, sizeof(struct timer_wheel));
+    Wheel->NextUnusedTimer = 1;
+    
+    Wheel->EntityTimers = EntityTimers;
+    Wheel->EntityTimerCapacity = EntityTimerCapacity;
+    if(EntityTimers)
+    {
+        memset(EntityTimers, 0, sizeof(uint32) * EntityTimerCapacity);
+    }
+}
+
+internal inline void
+TimerLinkSlot(timer_wheel *Wheel, uint32 TimerIndex)
+{
+    timer *Timer = &Wheel->Timers[TimerIndex];
+
+    // NOTE(Sleepster): Find the smallest level whose span still covers the remaining ticks,
+    //                  anything further out than the top level just waits a full rotation there.
+    uint64 Delta = Timer->ExpireTick - Wheel->CurrentTick;
+    uint32 Level = 0;
+    while(Level < TIMER_WHEEL_LEVELS - 1 &&
+          Delta >= (1ull << (TIMER_WHEEL_SLOT_BITS * (Level + 1))))
+    {
+        ++Level;
+    }
+
+    uint32 Slot = uint32(Timer->ExpireTick >> (TIMER_WHEEL_SLOT_BITS * Level)) & TIMER_WHEEL_SLOT_MASK;
+
+    Timer->Level    = uint8(Level);
+    Timer->Slot     = uint8(Slot);
+    Timer->SlotPrev = TIMER_NIL;
+    Timer->SlotNext = Wheel->Slots[Level][Slot];
+    if(Timer->SlotNext != TIMER_NIL)
+    {
+        Wheel->Timers[Timer->SlotNext].SlotPrev = TimerIndex;
+    }
+    Wheel->Slots[Level][Slot] = TimerIndex;
+}
+
+internal inline void
+TimerUnlinkSlot(timer_wheel *Wheel, uint32 TimerIndex)
+{
+    timer *Timer = &Wheel->Timers[TimerIndex];
+    if(Timer->SlotPrev != TIMER_NIL)
+    {
+        Wheel->Timers[Timer->SlotPrev].SlotNext = Timer->SlotNext;
+    }
+    else
+    {
+        Wheel->Slots[Timer->Level][Timer->Slot] = Timer->SlotNext;
+    }
+
+    if(Timer->SlotNext != TIMER_NIL)
+    {
+        Wheel->Timers[Timer->SlotNext].SlotPrev = Timer->SlotPrev;
+    }
+    Timer->SlotNext = TIMER_NIL;
+    Timer->SlotPrev = TIMER_NIL;
+}
+
+internal inline void
+TimerUnlinkEntity(timer_wheel *Wheel, uint32 TimerIndex)
+{
+    timer *Timer = &Wheel->Timers[TimerIndex];
+    if(Timer->EntityPrev != TIMER_NIL)
+    {
+        Wheel->Timers[Timer->EntityPrev].EntityNext = Timer->EntityNext;
+    }
+    else
+    {
+        Wheel->EntityTimers[Timer->EntityID] = Timer->EntityNext;
+    }
+
+    if(Timer->EntityNext != TIMER_NIL)
+    {
+        Wheel->Timers[Timer->EntityNext].EntityPrev = Timer->EntityPrev;
+    }
+    Timer->EntityNext = TIMER_NIL;
+    Timer->EntityPrev = TIMER_NIL;
+}
+
+internal inline void
+TimerFree(timer_wheel *Wheel, uint32 TimerIndex)
+{
+    timer *Timer = &Wheel->Timers[TimerIndex];
+    TimerUnlinkEntity(Wheel, TimerIndex);
+
+    Timer->IsActive = false;
+    ++Timer->Generation;
+
+    Timer->SlotNext = Wheel->FreeList;
+    Wheel->FreeList = TimerIndex;
+    --Wheel->ActiveTimerCount;
+}
+
+// NOTE(Sleepster): DelayTicks is clamped to at least one so a timer never fires on the tick it was scheduled on.
+//                  A PeriodTicks of 0 makes it a one shot.
+internal timer_handle
+TimerSchedule(timer_wheel *Wheel, timer_event_type Type, int32 EntityID, uint32 DelayTicks, uint32 PeriodTicks = 0, uint32 UserData = 0)
+{
+    timer_handle Result = {};
+
+    uint32 TimerIndex = TIMER_NIL;
+    if(Wheel->FreeList != TIMER_NIL)
+    {
+        TimerIndex = Wheel->FreeList;
+        Wheel->FreeList = Wheel->Timers[TimerIndex].SlotNext;
+    }
+    else if(Wheel->NextUnusedTimer < MAX_TIMERS)
+    {
+        TimerIndex = Wheel->NextUnusedTimer++;
+    }
+    Assert(TimerIndex != TIMER_NIL);
+
+    if(TimerIndex != TIMER_NIL)
+    {
+        timer *Timer = &Wheel->Timers[TimerIndex];
+        uint32 Generation = Timer->Generation + 1;
+        *Timer = {};
+
+        Timer->Generation = Generation;
+        Timer->ExpireTick = Wheel->CurrentTick + (DelayTicks ? DelayTicks : 1);
+        Timer->Period     = PeriodTicks;
+        Timer->Type       = Type;
+        Timer->EntityID   = EntityID;
+        Timer->UserData   = UserData;
+        Timer->IsActive   = true;
+
+        TimerLinkSlot(Wheel, TimerIndex);
+
+        Timer->EntityNext = Wheel->EntityTimers[EntityID];
+        if(Timer->EntityNext != TIMER_NIL)
+        {
+            Wheel->Timers[Timer->EntityNext].EntityPrev = TimerIndex;
+        }
+        Wheel->EntityTimers[EntityID] = TimerIndex;
+
+        ++Wheel->ActiveTimerCount;
+
+        Result.Index      = TimerIndex;
+        Result.Generation = Generation;
+    }
+
+    return(Result);
+}
+
+internal bool
+TimerCancel(timer_wheel *Wheel, timer_handle Handle)
+{
+    bool Result = false;
+    if(Handle.Index != TIMER_NIL && Handle.Index < MAX_TIMERS)
+    {
+        timer *Timer = &Wheel->Timers[Handle.Index];
+        if(Timer->IsActive && Timer->Generation == Handle.Generation)
+        {
+            TimerUnlinkSlot(Wheel, Handle.Index);
+            TimerFree(Wheel, Handle.Index);
+            Result = true;
+        }
+    }
+
+    return(Result);
+}
+
+internal void
+TimerCancelEntity(timer_wheel *Wheel, int32 EntityID)
+{
+    uint32 TimerIndex = Wheel->EntityTimers[EntityID];
+    while(TimerIndex != TIMER_NIL)
+    {
+        uint32 Next = Wheel->Timers[TimerIndex].EntityNext;
+        TimerUnlinkSlot(Wheel, TimerIndex);
+        TimerFree(Wheel, TimerIndex);
+
+        TimerIndex = Next;
+    }
+}
+
+internal void
+TimerWheelTick(game_state *State, timer_wheel *Wheel)
+{
+    uint64 Tick = ++Wheel->CurrentTick;
+
+    // NOTE(Sleepster): Whenever a level wraps, pull the next slot of the level above down into the finer levels.
+    for(uint32 Level = 1;
+        Level < TIMER_WHEEL_LEVELS;
+        ++Level)
+    {
+        if((Tick & ((1ull << (TIMER_WHEEL_SLOT_BITS * Level)) - 1)) != 0) break;
+
+        uint32 Slot = uint32(Tick >> (TIMER_WHEEL_SLOT_BITS * Level)) & TIMER_WHEEL_SLOT_MASK;
+        uint32 TimerIndex = Wheel->Slots[Level][Slot];
+        Wheel->Slots[Level][Slot] = TIMER_NIL;
+
+        while(TimerIndex != TIMER_NIL)
+        {
+            uint32 Next = Wheel->Timers[TimerIndex].SlotNext;
+            TimerLinkSlot(Wheel, TimerIndex);
+            TimerIndex = Next;
+        }
+    }
+
+    uint32 Slot = uint32(Tick) & TIMER_WHEEL_SLOT_MASK;
+    uint32 TimerIndex = Wheel->Slots[0][Slot];
+    Wheel->Slots[0][Slot] = TIMER_NIL;
+
+    uint32 FiredCount = 0;
+    uint32 TypeCounts[TIMER_EventCount] = {};
+    while(TimerIndex != TIMER_NIL)
+    {
+        timer *Timer = &Wheel->Timers[TimerIndex];
+        uint32 Next  = Timer->SlotNext;
+
+        timer_event *Event = &Wheel->FiredEvents[FiredCount++];
+        Event->Handle   = {TimerIndex, Timer->Generation};
+        Event->Type     = Timer->Type;
+        Event->EntityID = Timer->EntityID;
+        Event->UserData = Timer->UserData;
+        ++TypeCounts[Timer->Type];
+
+        if(Timer->Period)
+        {
+            Timer->ExpireTick += Timer->Period;
+            TimerLinkSlot(Wheel, TimerIndex);
+        }
+        else
+        {
+            TimerFree(Wheel, TimerIndex);
+        }
+        TimerIndex = Next;
+    }
+
+    if(FiredCount)
+    {
+        // NOTE(Sleepster): Counting sort so each callback gets every event of its type in one contiguous batch
+        uint32 TypeOffsets[TIMER_EventCount] = {};
+        for(uint32 TypeIndex = 1;
+            TypeIndex < TIMER_EventCount;
+            ++TypeIndex)
+        {
+            TypeOffsets[TypeIndex] = TypeOffsets[TypeIndex - 1] + TypeCounts[TypeIndex - 1];
+        }
+
+        uint32 WriteOffsets[TIMER_EventCount];
+        memcpy(WriteOffsets, TypeOffsets, sizeof(TypeOffsets));
+        for(uint32 EventIndex = 0;
+            EventIndex < FiredCount;
+            ++EventIndex)
+        {
+            timer_event *Event = &Wheel->FiredEvents[EventIndex];
+            Wheel->SortedEvents[WriteOffsets[Event->Type]++] = *Event;
+        }
+
+        for(uint32 TypeIndex = 0;
+            TypeIndex < TIMER_EventCount;
+            ++TypeIndex)
+        {
+            timer_callback *Callback = Wheel->Callbacks[TypeIndex];
+            if(Callback && TypeCounts[TypeIndex])
+            {
+                Callback(State, &Wheel->SortedEvents[TypeOffsets[TypeIndex]], TypeCounts[TypeIndex]);
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#if !defined(CLOVER_TIMERS_H)
+/* ========================================================================
+   $File: Clover_Timers.h $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define CLOVER_TIMERS_H
+
+#include "Intrinsics.h"
+#include "Clover_Globals.h"
+
+// NOTE(Sleepster): Hierarchical timing wheel that's ticked from GameFixedUpdate. Each level has 64 slots,
+//                  level N slots are 64^N ticks wide. Timers sit in an intrusive list for their slot AND
+//                  an intrusive list for their owning entity so scheduling and canceling are both O(1).
+//                  Nothing is touched until the slot a timer lives in comes around.
+constexpr uint32 TIMER_WHEEL_LEVELS    = 4;
+constexpr uint32 TIMER_WHEEL_SLOT_BITS = 6;
+constexpr uint32 TIMER_WHEEL_SLOTS     = 1 << TIMER_WHEEL_SLOT_BITS;
+constexpr uint32 TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+constexpr uint32 MAX_TIMERS            = 4096;
+
+// NOTE(Sleepster): Index 0 is the nil timer, every list terminates on it
+#define TIMER_NIL 0
+
+struct game_state;
+
+enum timer_event_type
+{
+    TIMER_Nil,
+    TIMER_ItemPickupReady,
+    TIMER_EventCount
+};
+
+struct timer_handle
+{
+    uint32 Index;
+    uint32 Generation;
+};
+
+struct timer_event
+{
+    timer_handle     Handle;
+    timer_event_type Type;
+    int32            EntityID;
+    uint32           UserData;
+};
+
+struct timer
+{
+    uint64           ExpireTick;
+    uint32           Period;
+    uint32           Generation;
+
+    timer_event_type Type;
+    int32            EntityID;
+    uint32           UserData;
+
+    uint32           SlotNext;
+    uint32           SlotPrev;
+    uint32           EntityNext;
+    uint32           EntityPrev;
+
+    uint8            Level;
+    uint8            Slot;
+    bool             IsActive;
+};
+
+#define TIMER_CALLBACK(name) void name(game_state *State, timer_event *Events, uint32 EventCount)
+typedef TIMER_CALLBACK(timer_callback);
+
+struct timer_wheel
+{
+    uint64 CurrentTick;
+    uint32 ActiveTimerCount;
+    uint32 FreeList;
+    uint32 NextUnusedTimer;
+
+    uint32 Slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    
+    // NOTE(Sleepster): Head timer for each entity index, allocated once alongside the entity storage 
+    uint32 *EntityTimers;
+    uint32  EntityTimerCapacity;
+    timer  Timers[MAX_TIMERS];
+
+    // NOTE(Sleepster): Scratch space for the events fired this tick, grouped by type before dispatch
+    timer_event FiredEvents[MAX_TIMERS];
+    timer_event SortedEvents[MAX_TIMERS];
+
+    timer_callback *Callbacks[TIMER_EventCount];
+};
+
+#endif // CLOVER_TIMERS_H
@@ -57,11 +57,7 @@ CloverUICreateElement(clover_ui_context *Context, ui_type Type)
 internal void
 CloverUIWidgetMakeXForm(ui_element *Widget)
 {
-    mat4 Identity    = mat4Identity(1.0f);
-    mat4 Translation = mat4Multiply(Identity, mat4Translate(v2Expand(Widget->Position, 0.0f)));
-    mat4 Scale       = mat4Multiply(Identity, mat4MakeScale(v2Expand(Widget->Size,     1.0f)));
-    
-    Widget->XForm = Translation * Scale;
+    Widget->XForm = affine2dMakeTRS(Widget->Position, 0.0f, Widget->Size);
 } 
 
 internal bool 
@@ -163,24 +159,9 @@ CloverUIMakeTextElement(clover_ui_context *Context,
     ui_element *TextElement = CloverUICreateElement(Context, UI_Text);
     
     vec2 TextOrigin = Position;
-    real32 TrueScale = FontScaleFactor / 100.0f;
     
-    vec2 TotalTextSize   = {};
-    TotalTextSize.Y = Context->ActiveFont->FontHeight * TrueScale; 
-    for(uint32 StringIndex = 0;
-        StringIndex < FormattedText.Length;
-        StringIndex++)
-    {
-        if(FormattedText.Data[StringIndex] == '\n') 
-        {
-            TotalTextSize.Y += Context->ActiveFont->FontHeight * TrueScale; 
-            continue; 
-        }
-        
-        char Character = (char)FormattedText.Data[StringIndex];
-        font_glyph Glyph = Context->ActiveFont->Glyphs[Character];
-        TotalTextSize.X += Glyph.GlyphAdvance.X * TrueScale;
-    }
+    text_layout *Layout = GetTextLayout(Context->RenderData, FormattedText, FontScaleFactor, Context->ActiveFontIndex);
+    vec2 TotalTextSize  = Layout->Extent;
     
     switch(Alignment)
     {
@@ -238,14 +219,15 @@ CloverUITextBox(clover_ui_context *Context,
 }
 
 internal ui_element_state
-CloverUISpriteElement(clover_ui_context *Context, vec2 Position, vec2 Size, mat4 XForm, static_sprite_data Sprite, vec4 Color)
+CloverUISpriteElement(clover_ui_context *Context, vec2 Position, vec2 Size, affine2d XForm, static_sprite_data Sprite, vec4 Color)
 {
     ui_element *SpriteElement = CloverUICreateElement(Context, UI_ItemSprite);
     SpriteElement->Position = Position;
     SpriteElement->Size = Size;
     SpriteElement->Sprite = Sprite;
     SpriteElement->DrawColor = Color;
-    if(XForm != NULLMATRIX)
+    // NOTE(Sleepster): A zeroed XForm means "build one from Position and Size" when drawn
+    if(affine2dDeterminant(XForm) != 0.0f)
     {
         SpriteElement->XForm = XForm;
     }
@@ -282,7 +264,7 @@ CloverUIDrawWidgets(gl_render_data *RenderData, clover_ui_context *Context)
         if(Widget)
         {
             // NOTE(Sleepster): Generating an XForm, It's required 
-            if(Widget->XForm == NULLMATRIX)
+            if(affine2dDeterminant(Widget->XForm) == 0.0f)
             {
                 CloverUIWidgetMakeXForm(Widget);
             }
@@ -297,8 +279,8 @@ CloverUIDrawWidgets(gl_render_data *RenderData, clover_ui_context *Context)
                                                      Widget->Sprite.AtlasOffset,
                                                      0,
                                                      Widget->DrawColor,
-                                                     0);
-                    DrawUIQuadXForm(RenderData, &WidgetQuad, &Widget->XForm, 0);
+                                                     Widget->Sprite.AtlasPage);
+                    DrawUIQuadAffine(RenderData, &WidgetQuad, &Widget->XForm, 0);
                 }break;
                 case UI_TextBox:
                 {
@@ -309,8 +291,8 @@ CloverUIDrawWidgets(gl_render_data *RenderData, clover_ui_context *Context)
                                                      Widget->Sprite.AtlasOffset,
                                                      0,
                                                      Widget->DrawColor,
-                                                     0);
-                    DrawUIQuadXForm(RenderData, &WidgetQuad, &Widget->XForm, 0);
+                                                     Widget->Sprite.AtlasPage);
+                    DrawUIQuadAffine(RenderData, &WidgetQuad, &Widget->XForm, 0);
                     DrawUIText(RenderData, Widget->ElementText, Widget->TextOrigin, Widget->FontScale, Context->ActiveFontIndex, Widget->TextDrawColor);
                 }break;
                 case UI_ItemSprite:
@@ -322,8 +304,8 @@ CloverUIDrawWidgets(gl_render_data *RenderData, clover_ui_context *Context)
                                                      Widget->Sprite.AtlasOffset,
                                                      0,
                                                      Widget->DrawColor,
-                                                     0);
-                    DrawUIQuadXForm(RenderData, &WidgetQuad, &Widget->XForm, 0);
+                                                     Widget->Sprite.AtlasPage);
+                    DrawUIQuadAffine(RenderData, &WidgetQuad, &Widget->XForm, 0);
                 }break;
                 case UI_Text:
                 {
@@ -90,7 +90,7 @@ struct ui_element
     bool IsActive;
     bool HasText;
     
-    mat4 XForm;
+    affine2d XForm;
 };
 
 struct ui_element_state
@@ -114,8 +114,9 @@ struct clover_ui_context
     mat4 UICameraViewMatrix;
     mat4 UICameraProjectionMatrix;
     
-    Input     *GameInput;
-    font_data *ActiveFont;
+    Input          *GameInput;
+    gl_render_data *RenderData;
+    font_data      *ActiveFont;
     font_index ActiveFontIndex;
     real32     LastActiveFontSize;
     
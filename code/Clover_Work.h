@@ -0,0 +1,32 @@
+#if !defined(CLOVER_WORK_H)
+/* ========================================================================
+   $File: Clover_Work.h $
+   $Date: October 19 2026 02:12 pm $
+   $Revision: $
+   $Creator: Justin Lewis $
+   ======================================================================== */
+
+#define CLOVER_WORK_H
+
+#include "Intrinsics.h"
+
+// NOTE(Sleepster): A batch of jobs that the main thread and up to one helper per worker claim in any order. The claim
+//                  word is [63:32] generation and [31:0] next job, a claim only lands if the word hasn't moved since
+//                  JobCount was read. Starting a batch bumps the generation first, so a helper that slept through the
+//                  last one can never claim a job out of the next one before it's filled in. The batch itself has to
+//                  outlive the run, a late helper still looks at it.
+#define WORK_BATCH_CALLBACK(name) void name(void *Data, uint32 JobIndex)
+typedef WORK_BATCH_CALLBACK(work_batch_callback);
+
+struct work_batch
+{
+    work_batch_callback *Callback;
+    void                *Data;
+
+    volatile uint64      Claim;
+    volatile uint32      JobCount;
+    volatile uint32      JobsRemaining;
+    volatile uint32      HelpersQueued;
+};
+
+#endif // CLOVER_WORK_H
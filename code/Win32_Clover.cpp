@@ -52,6 +52,9 @@
 // FILES FOR UNITY BUILD
 #include "Clover_Audio.cpp"
 #include "Clover_Renderer.cpp"
+#include "Clover_Atlas.cpp"
+#include "Clover_Software.cpp"
+#include "Clover_Capture.cpp"
 #include "Clover_Input.cpp"
 
 
@@ -317,6 +320,117 @@ Win32UnloadGameCode(game_functions *GameCode)
     GameCode->UpdateAndDraw = GameUpdateAndDrawStub;
 }
 
+// NOTE(Sleepster): "-entities N" picks the world's max entity count, pages are still only allocated as they're needed 
+internal uint32
+Win32ParseEntityCapacity(LPSTR CommandLine)
+{
+    uint32 Result = DEFAULT_ENTITY_CAPACITY;
+    if(CommandLine)
+    {
+        char *Flag = strstr(CommandLine, "-entities ");
+        if(Flag)
+        {
+            int64 Requested = atoll(Flag + sizeof("-entities ") - 1);
+            if(Requested > 0)
+            {
+                Result = uint32(Requested);
+            }
+        }
+    }
+    if(Result > MAX_ENTITY_PAGES * ENTITIES_PER_PAGE)
+    {
+        Result = MAX_ENTITY_PAGES * ENTITIES_PER_PAGE;
+    }
+    
+    return(Result);
+}
+
+// NOTE(Sleepster): "-software" renders on the CPU and never creates a GL context, "-frames N" quits after N frames
+internal bool8
+Win32ParseSoftwareRenderer(LPSTR CommandLine, uint32 *FrameLimit)
+{
+    bool8 Result = false;
+    *FrameLimit  = 0;
+    if(CommandLine)
+    {
+        Result = strstr(CommandLine, "-software") != 0;
+
+        char *Flag = strstr(CommandLine, "-frames ");
+        if(Flag)
+        {
+            int64 Requested = atoll(Flag + sizeof("-frames ") - 1);
+            if(Requested > 0)
+            {
+                *FrameLimit = uint32(Requested);
+            }
+        }
+    }
+
+    return(Result);
+}
+
+// NOTE(Sleepster): "-capture N" writes frame N's DrawFrame out, "-replay <file>" benchmarks a capture instead of running the game
+internal void
+Win32ParseFrameCapture(LPSTR CommandLine, uint32 *CaptureFrame, char *ReplayPath, uint32 ReplayPathSize)
+{
+    *CaptureFrame = 0;
+    ReplayPath[0] = 0;
+    if(CommandLine)
+    {
+        char *Flag = strstr(CommandLine, "-capture ");
+        if(Flag)
+        {
+            int64 Requested = atoll(Flag + sizeof("-capture ") - 1);
+            if(Requested > 0)
+            {
+                *CaptureFrame = uint32(Requested);
+            }
+        }
+
+        Flag = strstr(CommandLine, "-replay ");
+        if(Flag)
+        {
+            char  *Path   = Flag + sizeof("-replay ") - 1;
+            uint32 Length = 0;
+            while(Path[Length] && Path[Length] != ' ' && Length < ReplayPathSize - 1)
+            {
+                ReplayPath[Length] = Path[Length];
+                ++Length;
+            }
+            ReplayPath[Length] = 0;
+        }
+    }
+}
+
+// NOTE(Sleepster): Capped runs and replays are for benchmarks, they can't start before the atlas has landed
+internal void
+Win32WaitForSpriteAtlas(gl_render_data *RenderData)
+{
+    while(RenderData->SpriteAtlasGeneration == 0 && RenderData->AtlasBuild.State != ATLAS_BUILD_IDLE)
+    {
+        CloverProcessSpriteAtlasBuild(RenderData);
+        Sleep(1);
+    }
+}
+
+// NOTE(Sleepster): A positive biHeight is a bottom up DIB, same row order as the software framebuffer
+internal void
+Win32PresentSoftwareFrame(HDC WindowDC, software_renderer *Software)
+{
+    BITMAPINFO BitmapInfo = {};
+    BitmapInfo.bmiHeader.biSize        = sizeof(BitmapInfo.bmiHeader);
+    BitmapInfo.bmiHeader.biWidth       = Software->Width;
+    BitmapInfo.bmiHeader.biHeight      = Software->Height;
+    BitmapInfo.bmiHeader.biPlanes      = 1;
+    BitmapInfo.bmiHeader.biBitCount    = 32;
+    BitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+    StretchDIBits(WindowDC,
+                  0, 0, Software->Width, Software->Height,
+                  0, 0, Software->Width, Software->Height,
+                  Software->Pixels, &BitmapInfo, DIB_RGB_COLORS, SRCCOPY);
+}
+
 int CALLBACK
 WinMain(HINSTANCE hInstance,
         HINSTANCE hPrevInstance,
@@ -325,15 +439,24 @@ WinMain(HINSTANCE hInstance,
 {
     WNDCLASS              Window = {};
     time                  Time   = {};
-    game_state            State  = {};
+    game_state           *State  = {};
     game_memory           Memory = {};
     game_functions        Game   = {};
     wgl_function_pointers WGLFunctions  = {};
     gl_render_data        RenderData    = {};
+    work_queue            WorkQueue     = {};
+    
+    uint32 FrameLimit        = 0;
+    bool8  SoftwareRendering = Win32ParseSoftwareRenderer(lpCmdLine, &FrameLimit);
+    
+    uint32 CaptureFrame      = 0;
+    char   ReplayPath[MAX_PATH];
+    Win32ParseFrameCapture(lpCmdLine, &CaptureFrame, ReplayPath, MAX_PATH);
     
     // NOTE(Sleepster): Accumulator is for Delta Time
     real64 Accumulator = {};
     real32 FPSTimer = 0;
+    real32 SpriteDirectoryTimer = 0;
     
     LARGE_INTEGER PerfCountFrequencyResult;
     QueryPerformanceFrequency(&PerfCountFrequencyResult);
@@ -353,7 +476,10 @@ WinMain(HINSTANCE hInstance,
         SizeData.Width  = rect.right  - rect.left;
         SizeData.Height = rect.bottom - rect.top;
         
-        Win32LoadWGLFunctions(Window, hInstance, &WGLFunctions);
+        if(!SoftwareRendering)
+        {
+            Win32LoadWGLFunctions(Window, hInstance, &WGLFunctions);
+        }
         
         HWND WindowHandle =
             CreateWindowEx(WS_EX_CLIENTEDGE,
@@ -372,60 +498,92 @@ WinMain(HINSTANCE hInstance,
         {
             HDC WindowDC = GetDC(WindowHandle);
             
+            uint32 MaxEntityCount = Win32ParseEntityCapacity(lpCmdLine);
+            
             Memory.TemporaryStorage = ArenaCreate(Megabytes(512));
-            Memory.PermanentStorage = ArenaCreate(Megabytes(512));
+            Memory.PermanentStorage = ArenaCreate(Megabytes(512) + sizeof(game_state) + GetEntityStorageSize(MaxEntityCount));
             
-            RenderData.DrawFrame.Vertices = (vertex *)ArenaAlloc(&Memory.PermanentStorage, sizeof(vertex) * TRUE_MAX_VERTICES);
-            RenderData.DrawFrame.UIVertices = (vertex *)ArenaAlloc(&Memory.PermanentStorage, sizeof(vertex) * TRUE_MAX_VERTICES);
-            CloverResetRendererState(&RenderData);
+            // NOTE(Sleepster): game_state used to live on this stack, now it's in PermanentStorage with the entity pages 
+            State = (game_state *)ArenaAlloc(&Memory.PermanentStorage, sizeof(game_state));
+            State->World.MaxEntityCount = MaxEntityCount;
             
-            Win32LoadKeyData(&State);
-            Win32LoadDefaultBindings(&State.GameInput);
+            RenderData.FrameArena = &Memory.TemporaryStorage;
             
-            const int32 PixelAttributes[] =
-            {
-                WGL_DRAW_TO_WINDOW_ARB, GL_TRUE,
-                WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
-                WGL_DOUBLE_BUFFER_ARB,  GL_TRUE,
-                WGL_SWAP_METHOD_ARB,    WGL_SWAP_COPY_ARB,
-                WGL_PIXEL_TYPE_ARB,     WGL_TYPE_RGBA_ARB,
-                WGL_ACCELERATION_ARB,   WGL_FULL_ACCELERATION_ARB,
-                WGL_COLOR_BITS_ARB,     32,
-                WGL_ALPHA_BITS_ARB,     8,
-                WGL_DEPTH_BITS_ARB,     24,
-                0
-            };
+            Win32LoadKeyData(State);
+            Win32LoadDefaultBindings(&State->GameInput);
             
-            const int32 ContextAttributes[] =
+            if(!SoftwareRendering)
             {
-                WGL_CONTEXT_MAJOR_VERSION_ARB, 4,
-                WGL_CONTEXT_MINOR_VERSION_ARB, 3,
-                WGL_CONTEXT_PROFILE_MASK_ARB,  WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
-                WGL_CONTEXT_FLAGS_ARB,         WGL_CONTEXT_DEBUG_BIT_ARB,
-                0
-            };
+                const int32 PixelAttributes[] =
+                {
+                    WGL_DRAW_TO_WINDOW_ARB, GL_TRUE,
+                    WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
+                    WGL_DOUBLE_BUFFER_ARB,  GL_TRUE,
+                    WGL_SWAP_METHOD_ARB,    WGL_SWAP_COPY_ARB,
+                    WGL_PIXEL_TYPE_ARB,     WGL_TYPE_RGBA_ARB,
+                    WGL_ACCELERATION_ARB,   WGL_FULL_ACCELERATION_ARB,
+                    WGL_COLOR_BITS_ARB,     32,
+                    WGL_ALPHA_BITS_ARB,     8,
+                    WGL_DEPTH_BITS_ARB,     24,
+                    0
+                };
             
-            UINT NumPixelFormats;
-            int32 PixelFormat = 0;
-            if(!WGLFunctions.wglChoosePixelFormatARB(WindowDC, PixelAttributes, 0, 1, &PixelFormat, &NumPixelFormats))
-            {
-                Check(false, "Failed to choose the Main Pixel Format!\n");
-            }
+                const int32 ContextAttributes[] =
+                {
+                    WGL_CONTEXT_MAJOR_VERSION_ARB, 4,
+                    WGL_CONTEXT_MINOR_VERSION_ARB, 4,
+                    WGL_CONTEXT_PROFILE_MASK_ARB,  WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+                    WGL_CONTEXT_FLAGS_ARB,         WGL_CONTEXT_DEBUG_BIT_ARB,
+                    0
+                };
+            
+                UINT NumPixelFormats;
+                int32 PixelFormat = 0;
+                if(!WGLFunctions.wglChoosePixelFormatARB(WindowDC, PixelAttributes, 0, 1, &PixelFormat, &NumPixelFormats))
+                {
+                    Check(false, "Failed to choose the Main Pixel Format!\n");
+                }
             
-            PIXELFORMATDESCRIPTOR MainPixelFormat;
-            DescribePixelFormat(WindowDC, PixelFormat, sizeof(PIXELFORMATDESCRIPTOR), &MainPixelFormat);
-            SetPixelFormat(WindowDC, PixelFormat, &MainPixelFormat);
+                PIXELFORMATDESCRIPTOR MainPixelFormat;
+                DescribePixelFormat(WindowDC, PixelFormat, sizeof(PIXELFORMATDESCRIPTOR), &MainPixelFormat);
+                SetPixelFormat(WindowDC, PixelFormat, &MainPixelFormat);
             
-            HGLRC MainRenderingContext = WGLFunctions.wglCreateContextAttribsARB(WindowDC, 0, ContextAttributes);
-            wglMakeCurrent(WindowDC, MainRenderingContext);
-            gladLoadGL();
+                HGLRC MainRenderingContext = WGLFunctions.wglCreateContextAttribsARB(WindowDC, 0, ContextAttributes);
+                wglMakeCurrent(WindowDC, MainRenderingContext);
+                gladLoadGL();
             
-            // VSYNC
-            WGLFunctions.wglSwapIntervalEXT(0);
-            // VSYNC
+                // VSYNC
+                WGLFunctions.wglSwapIntervalEXT(0);
+                // VSYNC
+            }
+            
+            Win32CreateWorkQueue(&WorkQueue);
+            RenderData.WorkQueue          = &WorkQueue;
+            RenderData.CloverRunWorkBatch = Win32RunWorkBatch;
             
+            if(SoftwareRendering)
+            {
+                CloverSetupSoftwareRenderer(&Memory.TemporaryStorage, &RenderData);
+            }
+            else
+            {
+                CloverSetupRenderer(&Memory.TemporaryStorage, &RenderData);
+                RenderData.CloverRender = CloverRender;
+            }
+            CloverLoadSpriteAtlas(&Memory.PermanentStorage, &RenderData, SPRITE_DIRECTORY, SPRITE_ATLAS_CACHE_PATH);
+            CloverResetRendererState(&RenderData);
+            
+            if(ReplayPath[0])
+            {
+                frame_capture Capture = {};
+                if(CloverLoadFrameCapture(&Memory.PermanentStorage, ReplayPath, &Capture))
+                {
+                    Win32WaitForSpriteAtlas(&RenderData);
+                    CloverReplayFrameCapture(&RenderData, &Capture, FrameLimit > 0 ? FrameLimit : FRAME_REPLAY_DEFAULT_FRAMES);
+                }
+                return(0);
+            }
             
-            CloverSetupRenderer(&Memory.TemporaryStorage, &RenderData);
             Game = Win32LoadGameCode(STR("CloverGame.dll"));
             
             // NOTE(Sleepster): ImGui Setup 
@@ -445,17 +603,32 @@ WinMain(HINSTANCE hInstance,
             ImGui::StyleColorsDark();
             
             // Setup Platform/Renderer backends
-            ImGui_ImplWin32_InitForOpenGL(WindowHandle);
-            ImGui_ImplOpenGL3_Init();
+            if(SoftwareRendering)
+            {
+                // NOTE(Sleepster): Nothing draws the ImGui lists in software, the font atlas just has to exist for NewFrame
+                uint8 *ImGuiFontPixels;
+                int32  ImGuiFontWidth, ImGuiFontHeight;
+                ImGui_ImplWin32_Init(WindowHandle);
+                io.Fonts->GetTexDataAsRGBA32(&ImGuiFontPixels, &ImGuiFontWidth, &ImGuiFontHeight);
+            }
+            else
+            {
+                ImGui_ImplWin32_InitForOpenGL(WindowHandle);
+                ImGui_ImplOpenGL3_Init();
+            }
             
             
             // NOTE(Sleepster): Audio Engine setup, MiniAudio makes this REALLLLLLYYYYYYYY easy 
-            /* State.SFXData.AudioEngine = {}; */
-            /* Assert(ma_engine_init(0, &State.SFXData.AudioEngine) == MA_SUCCESS); */
-            /* Assert(ma_engine_set_volume(&State.SFXData.AudioEngine, 0.1f) == MA_SUCCESS); */
+            /* State->SFXData.AudioEngine = {}; */
+            /* Assert(ma_engine_init(0, &State->SFXData.AudioEngine) == MA_SUCCESS); */
+            /* Assert(ma_engine_set_volume(&State->SFXData.AudioEngine, 0.1f) == MA_SUCCESS); */
+            
+            // NOTE(Sleepster): OnAwake sizes every startup entity and its collider off of GetAtlasSprite, so the first
+            //                  atlas has to be in before it runs. ImGui and the rest of startup already overlapped the build.
+            Win32WaitForSpriteAtlas(&RenderData);
             
-            Game.OnAwake(&Memory, &RenderData, &State);
-            RenderData.CloverRender = CloverRender;
+            Game.OnAwake(&Memory, &RenderData, State);
+            uint32 FramesRendered = 0;
             
             Running = 1;
             LARGE_INTEGER LastCounter;
@@ -465,7 +638,7 @@ WinMain(HINSTANCE hInstance,
             while(Running)
             {
                 MSG Message = {};
-                Win32ProcessInputMessages(Message, WindowHandle, &State);
+                Win32ProcessInputMessages(Message, WindowHandle, State);
                 //DATA RELOADING
 #if CLOVER_SLOW
                 FILETIME NewDLLWriteTime = Win32GetLastWriteTime(STR("CloverGame.dll"));
@@ -476,28 +649,33 @@ WinMain(HINSTANCE hInstance,
                     
                     // NOTE(Sleepster): Audio Engine setup, MiniAudio makes this REALLLLLLYYYYYYYY easy 
                     Time.CurrentTimeInSeconds = 0.0f;
-                    Game.OnAwake(&Memory, &RenderData, &State);
+                    Game.OnAwake(&Memory, &RenderData, State);
                 }
 
-                // NOTE(Sleepster: Shader Reloading  
-                FILETIME NewTextureWriteTime        = Win32GetLastWriteTime(RenderData.GameAtlas.Filepath);    
-                FILETIME NewVertexShaderWriteTime   = Win32GetLastWriteTime(RenderData.BasicShader.VertexShader.Filepath);
-                FILETIME NewFragmentShaderWriteTime = Win32GetLastWriteTime(RenderData.BasicShader.FragmentShader.Filepath);
-
-                if(CompareFileTime(&NewTextureWriteTime, &RenderData.GameAtlas.LastWriteTime) != 0)
+                // NOTE(Sleepster): Texture and shader reloading. Walking the sprite directory is a FindFirstFile over
+                //                  every file in it, so that only happens about once a second instead of every frame.
+                SpriteDirectoryTimer += Time.Delta;
+                if(SpriteDirectoryTimer >= 1)
                 {
-                    CloverReloadTexture(&RenderData, &RenderData.GameAtlas, 0);
-                    Sleep(100);
+                    SpriteDirectoryTimer = 0;
+
+                    FILETIME NewTextureWriteTime = CloverGetSpriteDirectoryWriteTime(RenderData.GameAtlas.Filepath);
+                    if(CompareFileTime(&NewTextureWriteTime, &RenderData.GameAtlas.LastWriteTime) != 0)
+                    {
+                        // NOTE(Sleepster): No need to sleep for the editor to finish writing, a later write just queues another build
+                        CloverLoadSpriteAtlas(&Memory.PermanentStorage, &RenderData, SPRITE_DIRECTORY, SPRITE_ATLAS_CACHE_PATH);
+                    }
                 }
 
-                if(CompareFileTime(&NewVertexShaderWriteTime,   &RenderData.BasicShader.VertexShader.LastWriteTime) != 0 ||
-                   CompareFileTime(&NewFragmentShaderWriteTime, &RenderData.BasicShader.FragmentShader.LastWriteTime) != 0)
+                if(!SoftwareRendering)
                 {
-                    glDeleteProgram(RenderData.BasicShader.ShaderID);
-                    CloverCreateShader(&Memory.TemporaryStorage, RenderData.BasicShader.VertexShader.Filepath, RenderData.BasicShader.FragmentShader.Filepath);
-                    Sleep(100);
+                    CloverReloadShaders(&Memory.TemporaryStorage, &RenderData);
                 }
 #endif
+                // NOTE(Sleepster): Picks up anything the workers finished, before the game pulls sprite data
+                CloverProcessSpriteAtlasBuild(&RenderData);
+                CloverProcessFontBakes(&RenderData);
+                
                 real64 NewTime     = GetLastTime();
                 CurrentTime = NewTime;
                 
@@ -505,33 +683,65 @@ WinMain(HINSTANCE hInstance,
                 Time.Current = (real32)CurrentTime;
                 while(Accumulator >= SIMRATE)
                 {
-                    Game.FixedUpdate(&Memory, &RenderData, &State, Time);
-                    Accumulator -= Time.Delta;
+                    Game.FixedUpdate(&Memory, &RenderData, State, Time);
+                    Accumulator -= SIMRATE;
                     Time.CurrentTimeInSeconds = real32(GetCurrentTimeInSeconds());
                 }
                 
                 Accumulator += Time.Delta;
 
-                glViewport(0, 0, SizeData.Width, SizeData.Height);
-                glClearColor(RenderData.ClearColor.R, RenderData.ClearColor.G, RenderData.ClearColor.B, RenderData.ClearColor.A);
-                glClearDepth(0.0f);
-                glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
-                
-                // Start the Dear ImGui frame
-                ImGui_ImplOpenGL3_NewFrame();
+                if(!SoftwareRendering)
+                {
+                    glViewport(0, 0, SizeData.Width, SizeData.Height);
+                    glClearColor(RenderData.ClearColor.R, RenderData.ClearColor.G, RenderData.ClearColor.B, RenderData.ClearColor.A);
+                    glClearDepth(0.0f);
+                    glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
+                    
+                    // Start the Dear ImGui frame
+                    ImGui_ImplOpenGL3_NewFrame();
+                }
                 ImGui_ImplWin32_NewFrame();
                 ImGui::NewFrame();
                 
-                RenderData.AspectRatio = (real32)SizeData.Width / (real32)SizeData.Height;
-                Game.UpdateAndDraw(&Memory, &RenderData, &State, Time, SizeData);
+                RenderData.AspectRatio   = (real32)SizeData.Width / (real32)SizeData.Height;
+                RenderData.AnimationTime = Time.CurrentTimeInSeconds;
+                Game.UpdateAndDraw(&Memory, &RenderData, State, Time, SizeData);
                 
                 ImGui::Render();
 
-                CloverRender(&RenderData);
+                if(RenderData.CaptureRequested || (CaptureFrame > 0 && FramesRendered + 1 == CaptureFrame))
+                {
+                    char CapturePath[MAX_PATH];
+                    snprintf(CapturePath, sizeof(CapturePath), "%s/Frame%05u.capture", FRAME_CAPTURE_DIRECTORY, FramesRendered + 1);
+                    CloverCaptureFrame(&RenderData, CapturePath);
+                    RenderData.CaptureRequested = false;
+                }
+                
+                CloverFlushGlyphCache(&RenderData);
+                RenderData.CloverRender(&RenderData);
                 //CloverRenderTestGBuffer(&RenderData);
 
-                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-                SwapBuffers(WindowDC);
+                if(SoftwareRendering)
+                {
+                    Win32PresentSoftwareFrame(WindowDC, &RenderData.Software);
+                }
+                else
+                {
+                    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+                    SwapBuffers(WindowDC);
+                }
+                
+                ++FramesRendered;
+                if(FrameLimit > 0 && FramesRendered >= FrameLimit)
+                {
+                    if(SoftwareRendering)
+                    {
+                        CloverWriteSoftwareFrame(&Memory.TemporaryStorage, &RenderData.Software, SOFTWARE_FRAME_PATH);
+                        printm("Software: %llu quads in %.03fs, %.0f quads/sec\n",
+                               RenderData.Software.QuadsRasterized, RenderData.Software.SecondsRasterizing, RenderData.Software.QuadsPerSecond);
+                    }
+                    Running = false;
+                }
                 
                 ArenaReset(&Memory.TemporaryStorage);
                 
@@ -17,6 +17,174 @@ struct wgl_function_pointers
     PFNWGLSWAPINTERVALEXTPROC         wglSwapIntervalEXT;
 };
 
+// NOTE(Sleepster): Any thread can add work, the add lock keeps two producers from claiming the same slot.
+//                  Workers sleep on the semaphore when the queue runs dry and take entries with a compare exchange.
+constexpr uint32 MAX_WORK_QUEUE_ENTRIES = 256;
+constexpr uint32 MAX_WORKER_THREADS     = 8;
+
+struct work_queue;
+#define WORK_QUEUE_CALLBACK(name) void name(work_queue *Queue, void *Data)
+typedef WORK_QUEUE_CALLBACK(work_queue_callback);
+
+struct work_queue_entry
+{
+    work_queue_callback *Callback;
+    void                *Data;
+};
+
+struct work_queue
+{
+    volatile LONG    NextEntryToWrite;
+    volatile LONG    NextEntryToRead;
+    volatile LONG    AddLock;
+    
+    HANDLE           SemaphoreHandle;
+    uint32           ThreadCount;
+    work_queue_entry Entries[MAX_WORK_QUEUE_ENTRIES];
+};
+
+internal void
+Win32AddWorkEntry(work_queue *Queue, work_queue_callback *Callback, void *Data)
+{
+    while(InterlockedCompareExchange(&Queue->AddLock, 1, 0) != 0)
+    {
+        _mm_pause();
+    }
+    
+    uint32 EntryIndex          = uint32(Queue->NextEntryToWrite);
+    uint32 NewNextEntryToWrite = (EntryIndex + 1) % MAX_WORK_QUEUE_ENTRIES;
+    Check(NewNextEntryToWrite != uint32(Queue->NextEntryToRead), "The work queue is full\n");
+    
+    Queue->Entries[EntryIndex].Callback = Callback;
+    Queue->Entries[EntryIndex].Data     = Data;
+    
+    _ReadWriteBarrier();
+    InterlockedExchange(&Queue->NextEntryToWrite, LONG(NewNextEntryToWrite));
+    InterlockedExchange(&Queue->AddLock, 0);
+    
+    ReleaseSemaphore(Queue->SemaphoreHandle, 1, 0);
+}
+
+// NOTE(Sleepster): Returns true if there was anything to take, even if another thread beat us to it,
+//                  so the caller knows whether it's worth trying again right away
+internal bool8
+Win32DoNextWorkEntry(work_queue *Queue)
+{
+    bool8  Result = false;
+    uint32 OriginalNextEntryToRead = uint32(Queue->NextEntryToRead);
+    if(OriginalNextEntryToRead != uint32(Queue->NextEntryToWrite))
+    {
+        uint32 NewNextEntryToRead = (OriginalNextEntryToRead + 1) % MAX_WORK_QUEUE_ENTRIES;
+        LONG   EntryIndex = InterlockedCompareExchange(&Queue->NextEntryToRead, LONG(NewNextEntryToRead), LONG(OriginalNextEntryToRead));
+        if(uint32(EntryIndex) == OriginalNextEntryToRead)
+        {
+            work_queue_entry Entry = Queue->Entries[EntryIndex];
+            Entry.Callback(Queue, Entry.Data);
+        }
+        Result = true;
+    }
+    
+    return(Result);
+}
+
+constexpr uint32 WORK_BATCH_PARKED = 0xFFFFFFFF;
+
+internal bool8
+Win32ClaimWorkBatchJob(work_batch *Batch)
+{
+    bool8 Result = false;
+    for(;;)
+    {
+        uint64 Claim    = Batch->Claim;
+        uint32 JobIndex = uint32(Claim & 0xFFFFFFFF);
+        if(JobIndex >= Batch->JobCount) break;
+
+        if(uint64(InterlockedCompareExchange64((volatile LONG64 *)&Batch->Claim, LONG64(Claim + 1), LONG64(Claim))) == Claim)
+        {
+            Batch->Callback(Batch->Data, JobIndex);
+            InterlockedDecrement((volatile LONG *)&Batch->JobsRemaining);
+            Result = true;
+            break;
+        }
+    }
+
+    return(Result);
+}
+
+internal
+WORK_QUEUE_CALLBACK(Win32WorkBatchHelper)
+{
+    work_batch *Batch = (work_batch *)Data;
+    InterlockedDecrement((volatile LONG *)&Batch->HelpersQueued);
+    while(Win32ClaimWorkBatchJob(Batch));
+}
+
+// NOTE(Sleepster): Returns once every job has run. The main thread only ever runs this batch's jobs while it waits,
+//                  never another system's entry off the shared queue.
+internal void
+Win32RunWorkBatch(work_queue *Queue, work_batch *Batch, work_batch_callback *Callback, void *Data, uint32 JobCount)
+{
+    if(JobCount == 0) return;
+
+    uint64 Generation = (Batch->Claim >> 32) + 1;
+    InterlockedExchange64((volatile LONG64 *)&Batch->Claim, LONG64((Generation << 32) | WORK_BATCH_PARKED));
+    Batch->Callback      = Callback;
+    Batch->Data          = Data;
+    Batch->JobCount      = JobCount;
+    Batch->JobsRemaining = JobCount;
+    InterlockedExchange64((volatile LONG64 *)&Batch->Claim, LONG64(Generation << 32));
+
+    // NOTE(Sleepster): One helper per worker at most, anything still queued from an earlier run counts
+    uint32 HelperCount = MIN(JobCount - 1, Queue->ThreadCount);
+    while(Batch->HelpersQueued < HelperCount)
+    {
+        InterlockedIncrement((volatile LONG *)&Batch->HelpersQueued);
+        Win32AddWorkEntry(Queue, Win32WorkBatchHelper, Batch);
+    }
+
+    while(Win32ClaimWorkBatchJob(Batch));
+    while(Batch->JobsRemaining > 0)
+    {
+        _mm_pause();
+    }
+}
+
+internal DWORD WINAPI
+Win32WorkerThreadProc(LPVOID Parameter)
+{
+    work_queue *Queue = (work_queue *)Parameter;
+    for(;;)
+    {
+        if(!Win32DoNextWorkEntry(Queue))
+        {
+            WaitForSingleObjectEx(Queue->SemaphoreHandle, INFINITE, FALSE);
+        }
+    }
+}
+
+internal void
+Win32CreateWorkQueue(work_queue *Queue)
+{
+    SYSTEM_INFO SystemInfo = {};
+    GetSystemInfo(&SystemInfo);
+    
+    // NOTE(Sleepster): One core stays with the main thread
+    uint32 ThreadCount = uint32(SystemInfo.dwNumberOfProcessors) > 1 ? uint32(SystemInfo.dwNumberOfProcessors) - 1 : 1;
+    Queue->ThreadCount = MIN(ThreadCount, MAX_WORKER_THREADS);
+    
+    Queue->NextEntryToWrite = 0;
+    Queue->NextEntryToRead  = 0;
+    Queue->AddLock          = 0;
+    Queue->SemaphoreHandle  = CreateSemaphoreEx(0, 0, MAX_WORK_QUEUE_ENTRIES, 0, 0, SEMAPHORE_ALL_ACCESS);
+    for(uint32 ThreadIndex = 0;
+        ThreadIndex < Queue->ThreadCount;
+        ++ThreadIndex)
+    {
+        HANDLE ThreadHandle = CreateThread(0, 0, Win32WorkerThreadProc, Queue, 0, 0);
+        CloseHandle(ThreadHandle);
+    }
+}
+
 internal inline FILETIME
 Win32MaxFiletime(FILETIME A, FILETIME B)
 {
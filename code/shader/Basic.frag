@@ -5,12 +5,23 @@
 #include "/../code/shader/CommonShader.glh"
 #line 6
 
-layout(std430, binding = 0) buffer PointLightSBO
+layout(std430, binding = 0) readonly buffer PointLightSBO
 {
     point_light PointLights[];  
 };
 
-uniform int   PointLightCount;
+// NOTE(Sleepster): Built by CloverBinPointLights, (First, Count) per LIGHT_TILE_SIZE screen tile into LightIndices
+layout(std430, binding = 2) readonly buffer LightTileSBO
+{
+    uvec2 LightTiles[];
+};
+
+layout(std430, binding = 3) readonly buffer LightIndexSBO
+{
+    uint LightIndices[];
+};
+
+uniform uint  LightTileCountX;
 uniform float uBrightness;
 
 // IN FROM VERTEX SHADER
@@ -18,11 +29,12 @@ in vec3   vFragPos;
 in vec2   vTextureUVs;
 in vec3   vNormals;
 in vec4   vMatColor;
-in real32 vTextureIndex;
+flat in uint vTextureLayer;
+flat in uint vTextureFlags;
 
 // TEXTURES
-layout(binding = 0) uniform sampler2D GameAtlas;
-layout(binding = 1) uniform sampler2D FontAtlas;
+layout(binding = 0) uniform sampler2DArray GameAtlas;
+layout(binding = 1) uniform sampler2DArray FontAtlas;
 
 // OUTPUT COLOR
 out vec4 FragColor;
@@ -30,7 +42,7 @@ out vec4 FragColor;
 void main()
 {
     // GAME TEXTURES
-    if(int(vTextureIndex) == 0)
+    if((vTextureFlags & RENDERING_OPTION_FONT) == 0u)
     {
         float AmbientStrength = 1.0;
         vec3  GlobalAmbientColor = vec3(0.8);
@@ -39,12 +51,18 @@ void main()
         vec3  Norm = normalize(vNormals);
 
         vec3  TotalLighting = vec3(0.0);
-        for(int LightIndex = 0; LightIndex < PointLightCount; ++LightIndex)
+        uvec2 Tile = uvec2(gl_FragCoord.xy) / LIGHT_TILE_SIZE;
+        uvec2 TileLights = LightTiles[Tile.y * LightTileCountX + Tile.x];
+        for(uint TileLight = 0u; TileLight < TileLights.y; ++TileLight)
         {
-            point_light PointLight = PointLights[LightIndex];
+            point_light PointLight = PointLights[LightIndices[TileLights.x + TileLight]];
 
             vec3 LightDir = normalize(PointLight.Position - vFragPos);
             float LightDist = length(PointLight.Position - vFragPos);
+            if(LightDist > PointLight.Radius)
+            {
+                continue;
+            }
 
             float Attenuation = 1.0 / (PointLight.Attenuation.Constant 
                                  + PointLight.Attenuation.Linear * LightDist 
@@ -55,7 +73,7 @@ void main()
 
             TotalLighting += AmbientLight + Diffuse;
         }
-        vec4 TextureColor = texelFetch(GameAtlas, ivec2(vTextureUVs), 0);
+        vec4 TextureColor = texelFetch(GameAtlas, ivec3(ivec2(vTextureUVs), vTextureLayer), 0);
         if (TextureColor.a <= 0.1)
         {
             discard;
@@ -71,15 +89,12 @@ void main()
             FragColor = vec4((TotalLighting), 1.0) * ObjectColor;
         }
     }
-
-    // FONT RENDERERING
-    if(int(vTextureIndex) == 1)
+    else
     {
-        // NOTE(Sleepster): 512 is the size of the game texture, if you change the size of the game of the texture, change this to that size 
-        real32 NormalizedTextureUVX = vTextureUVs.x / 512;
-        real32 NormalizedTextureUVY = vTextureUVs.y / 512;
+        // FONT RENDERERING
+        vec2 NormalizedTextureUVs = vTextureUVs / vec2(textureSize(FontAtlas, 0).xy);
 
-        real32 Distance = texture(FontAtlas, vec2(NormalizedTextureUVX, NormalizedTextureUVY)).r;
+        real32 Distance = texture(FontAtlas, vec3(NormalizedTextureUVs, float(vTextureLayer))).r;
         real32 SmoothEdge = 0.05;
         real32 Alpha = smoothstep(0.5 - SmoothEdge, 0.5 + SmoothEdge, Distance);
         
@@ -0,0 +1,21 @@
+#version 430 core
+#extension GL_ARB_shading_language_include : require
+
+#line 4
+#include "/../code/shader/CommonShader.glh"
+#line 6
+
+layout(binding = 0) uniform sampler2D gColor;
+layout(binding = 1) uniform sampler2D Lightmap;
+
+out vec4 FragColor;
+
+void main()
+{
+    ivec2 Pixel       = ivec2(gl_FragCoord.xy);
+    vec4  AlbedoColor = texelFetch(gColor, Pixel, 0);
+    vec3  LightColor  = texelFetch(Lightmap, Pixel, 0).rgb;
+
+    // NOTE(Sleepster): Unlit pixels come through exactly as the g-buffer has them, lights only ever add on top
+    FragColor = vec4(AlbedoColor.rgb * (vec3(1.0) + LightColor), AlbedoColor.a);
+}
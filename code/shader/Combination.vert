@@ -0,0 +1,13 @@
+#version 430 core
+#extension GL_ARB_shading_language_include : require
+
+#line 4
+#include "/../code/shader/CommonShader.glh"
+#line 6
+
+// NOTE(Sleepster): One triangle that covers the whole screen, no vertex data
+void main()
+{
+    vec2 Corner = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    gl_Position = vec4((Corner * 2.0) - 1.0, 0.0, 1.0);
+}
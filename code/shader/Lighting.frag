@@ -0,0 +1,45 @@
+#version 430 core
+#extension GL_ARB_shading_language_include : require
+
+#line 4
+#include "/../code/shader/CommonShader.glh"
+#line 6
+
+layout(std430, binding = 0) readonly buffer PointLightSBO
+{
+    point_light PointLights[];  
+};
+
+in vec2      vClipPos;
+flat in uint vLightIndex;
+
+layout(binding = 2) uniform sampler2D gNormals;
+
+// NOTE(Sleepster): Blended additively into the lightmap, one fragment per light per covered pixel
+out vec4 LightColor;
+
+void main()
+{
+    // NOTE(Sleepster): The normal attachment is cleared to zero, anything else is opaque geometry
+    vec3 Normal = texelFetch(gNormals, ivec2(gl_FragCoord.xy), 0).rgb;
+    if(Normal == vec3(0.0))
+    {
+        discard;
+    }
+
+    point_light PointLight = PointLights[vLightIndex];
+    float LightDist = length(PointLight.Position.xy - vClipPos);
+    if(LightDist > PointLight.Radius)
+    {
+        discard;
+    }
+
+    float Attenuation = 1.0 / (PointLight.Attenuation.Constant 
+                         + PointLight.Attenuation.Linear * LightDist 
+                         + PointLight.Attenuation.Quadratic * (LightDist * LightDist));
+    // NOTE(Sleepster): Sprites all face the camera so there's no N dot L yet, same as the forward path 
+    float Diff    = 1.0;
+    vec3  Diffuse = Diff * PointLight.LightColor.rgb * Attenuation * PointLight.Strength;
+
+    LightColor = vec4(Diffuse, 1.0);
+}
@@ -0,0 +1,28 @@
+#version 430 core
+#extension GL_ARB_shading_language_include : require
+
+#line 4
+#include "/../code/shader/CommonShader.glh"
+#line 6
+
+layout(std430, binding = 0) readonly buffer PointLightSBO
+{
+    point_light PointLights[];  
+};
+
+// NOTE(Sleepster): One instance per point light, each is a quad bounding its radius so only the pixels it can reach get shaded
+const vec2 QuadCorners[6] = vec2[6](vec2(-1.0,  1.0), vec2( 1.0,  1.0), vec2( 1.0, -1.0),
+                                    vec2( 1.0, -1.0), vec2(-1.0, -1.0), vec2(-1.0,  1.0));
+
+out vec2      vClipPos;
+flat out uint vLightIndex;
+
+void main()
+{
+    point_light PointLight = PointLights[gl_InstanceID];
+    vec2 ClipPos = PointLight.Position.xy + (QuadCorners[gl_VertexID] * PointLight.Radius);
+
+    vClipPos    = ClipPos;
+    vLightIndex = uint(gl_InstanceID);
+    gl_Position = vec4(ClipPos, 0.0, 1.0);
+}
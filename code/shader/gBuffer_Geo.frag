@@ -11,16 +11,16 @@ in vec2 vTextureUVs;
 in vec3 vFragPos;
 in vec3 vNormals;
 in vec4 vMatColor;
+flat in uint vTextureLayer;
 
 layout(location = 0) out vec4 gColor;
 layout(location = 1) out vec3 gNormals;
 
-layout(binding = 0) uniform sampler2D GameAtlas;
-layout(binding = 1) uniform sampler2D NormalAtlas;
+layout(binding = 0) uniform sampler2DArray GameAtlas;
 
 void main()
 {
-    vec4 TexelColor = texelFetch(GameAtlas, ivec2(vTextureUVs), 0);
+    vec4 TexelColor = texelFetch(GameAtlas, ivec3(ivec2(vTextureUVs), vTextureLayer), 0);
     if(TexelColor.a == 0.0)
     {
         discard;    
@@ -5,28 +5,61 @@
 #include "/../code/shader/CommonShader.glh"
 #line 6
 
-layout(location = 0) in vec3   VertexPos;
-layout(location = 1) in vec2   TextureCoords;
-layout(location = 2) in vec3   VertexNormals;
+// NOTE(Sleepster): One sprite_instance per sprite, every attribute steps per instance. Size is the full extent,
+//                  AtlasRect is (X, Y, W, H) texels and AnimParams are unorm scaled by the SPRITE_ANIM ranges
+layout(location = 0) in vec2   InstancePos;
+layout(location = 1) in vec2   InstanceSize;
+layout(location = 2) in float  InstanceRotation;
 layout(location = 3) in vec4   MatColor;
-layout(location = 4) in float  TextureIndex;
+layout(location = 4) in uvec2  InstanceIndexFlags;
+layout(location = 5) in vec3   AnimParams;
+layout(location = 6) in vec4   AtlasRect;
 
-uniform mat4 ProjectionMatrix;
-uniform mat4 ViewMatrix;
+// NOTE(Sleepster): Two triangles, TopLeft TopRight BottomRight / BottomRight BottomLeft TopLeft
+const vec2 QuadCorners[6] = vec2[6](vec2(-0.5,  0.5), vec2( 0.5,  0.5), vec2( 0.5, -0.5),
+                                    vec2( 0.5, -0.5), vec2(-0.5, -0.5), vec2(-0.5,  0.5));
+
+// NOTE(Sleepster): Every sprite is a flat quad facing the camera
+const vec3 VertexNormals = vec3(0.0, 0.0, 1.0);
+
+uniform mat4  ProjectionMatrix;
+uniform mat4  ViewMatrix;
+uniform float uTime;
 
 out vec3  vFragPos;
 out vec2  vTextureUVs;
 out vec3  vNormals;
 out vec4  vMatColor;
-out float vTextureIndex;
+
+// NOTE(Sleepster): Layer in the sprite or font atlas array, the FONT flag says which
+flat out uint vTextureLayer;
+flat out uint vTextureFlags;
 
 void main()
 {
-    vTextureUVs   = TextureCoords;
+    vec2 Corner   = QuadCorners[gl_VertexID];
+    vec2 CornerUV = vec2(Corner.x + 0.5, 0.5 - Corner.y);
+    if((InstanceIndexFlags.y & RENDERING_OPTION_FLIP_X) != 0u) CornerUV.x = 1.0 - CornerUV.x;
+    if((InstanceIndexFlags.y & RENDERING_OPTION_FLIP_Y) != 0u) CornerUV.y = 1.0 - CornerUV.y;
+
+    vTextureUVs   = AtlasRect.xy + (CornerUV * AtlasRect.zw);
     vNormals      = VertexNormals; 
     vMatColor     = MatColor;
-    vTextureIndex = TextureIndex;
+    vTextureLayer = InstanceIndexFlags.x;
+    vTextureFlags = InstanceIndexFlags.y;
+
+    float SinTheta = sin(InstanceRotation);
+    float CosTheta = cos(InstanceRotation);
+    vec2  Local    = Corner * InstanceSize;
+    vec3  WorldPos = vec3(InstancePos + vec2((CosTheta * Local.x) - (SinTheta * Local.y),
+                                             (SinTheta * Local.x) + (CosTheta * Local.y)), 0.0);
+
+    // NOTE(Sleepster): Idle bob, AnimParams = (Phase, Amplitude, Frequency). Zero amplitude for everything static
+    float Phase     = AnimParams.x * SPRITE_ANIM_PHASE_RANGE;
+    float Amplitude = AnimParams.y * SPRITE_ANIM_AMPLITUDE_RANGE;
+    float Frequency = AnimParams.z * SPRITE_ANIM_FREQUENCY_RANGE;
+    WorldPos.y += Amplitude * sin(Phase + (uTime * Frequency));
 
-    vFragPos = (ProjectionMatrix * ViewMatrix * vec4(VertexPos, 1.0f)).xyz;
-    gl_Position = ProjectionMatrix * ViewMatrix * vec4(VertexPos, 1.0f); 
+    vFragPos = (ProjectionMatrix * ViewMatrix * vec4(WorldPos, 1.0f)).xyz;
+    gl_Position = ProjectionMatrix * ViewMatrix * vec4(WorldPos, 1.0f); 
 }
@@ -40,6 +40,57 @@ StringsMatch(string A, string B)
     return(memcmp(A.Data, B.Data, A.Length) == 0);
 }
 
+// NOTE(Sleepster): Decodes the codepoint at *Index and moves *Index past it, malformed bytes come back as U+FFFD
+internal inline uint32
+DecodeUTF8(string Text, uint64 *Index)
+{
+    uint8  Lead      = Text.Data[*Index];
+    uint32 Length    = 1;
+    uint32 Codepoint = Lead;
+    if(Lead >= 0xF0)
+    {
+        Length    = 4;
+        Codepoint = Lead & 0x07;
+    }
+    else if(Lead >= 0xE0)
+    {
+        Length    = 3;
+        Codepoint = Lead & 0x0F;
+    }
+    else if(Lead >= 0xC0)
+    {
+        Length    = 2;
+        Codepoint = Lead & 0x1F;
+    }
+    else if(Lead >= 0x80)
+    {
+        *Index += 1;
+        return(0xFFFD);
+    }
+
+    if(*Index + Length > Text.Length)
+    {
+        *Index = Text.Length;
+        return(0xFFFD);
+    }
+
+    for(uint32 ByteIndex = 1;
+        ByteIndex < Length;
+        ++ByteIndex)
+    {
+        uint8 Byte = Text.Data[*Index + ByteIndex];
+        if((Byte & 0xC0) != 0x80)
+        {
+            *Index += ByteIndex;
+            return(0xFFFD);
+        }
+        Codepoint = (Codepoint << 6) | (Byte & 0x3F);
+    }
+
+    *Index += Length;
+    return(Codepoint);
+}
+
 internal inline string
 HeapString(memory_arena *Scratch, uint64 Length)
 {
@@ -589,6 +589,14 @@ typedef union mat4
 #endif
 } mat4;
 
+// NOTE(Sleepster): 2x3 affine transform for 2D. X and Y are the basis columns, Offset is the translation.
+typedef struct affine2d
+{
+    vec2 X;
+    vec2 Y;
+    vec2 Offset;
+} affine2d;
+
 typedef union quat
 {
     struct
@@ -741,6 +749,39 @@ Equals(real32 A, real32 B, real32 Tolerance)
     return(fabs(A - B) <= Tolerance);
 }
 
+// NOTE(Sleepster): IEEE 754 half, truncates the mantissa and flushes denormals to zero. Only meant for vertex attributes
+internal inline uint16
+FloatToHalf(real32 Value)
+{
+    uint32 Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+    
+    uint32 Sign     = (Bits >> 16) & 0x8000;
+    int32  Exponent = int32((Bits >> 23) & 0xFF) - 127 + 15;
+    uint32 Mantissa = Bits & 0x007FFFFF;
+    
+    if(Exponent <= 0)  return(uint16(Sign));
+    if(Exponent >= 31) return(uint16(Sign | 0x7C00));
+    return(uint16(Sign | (Exponent << 10) | (Mantissa >> 13)));
+}
+
+// NOTE(Sleepster): Inverse of FloatToHalf, denormals come back as zero and infinities stay infinite
+internal inline real32
+HalfToFloat(uint16 Value)
+{
+    uint32 Sign     = uint32(Value & 0x8000) << 16;
+    uint32 Exponent = (Value >> 10) & 0x1F;
+    uint32 Mantissa = Value & 0x03FF;
+    
+    uint32 Bits = Sign;
+    if(Exponent == 31)     Bits |= 0x7F800000 | (Mantissa << 13);
+    else if(Exponent != 0) Bits |= ((Exponent - 15 + 127) << 23) | (Mantissa << 13);
+    
+    real32 Result;
+    memcpy(&Result, &Bits, sizeof(Result));
+    return(Result);
+}
+
 
 internal inline void
 Approach(real32 *Value, real32 Target, real32 Rate, real32 Delta_t)
@@ -1755,6 +1796,100 @@ static inline mat4 mat4Inverse(mat4 Matrix)
     return mat4Transpose(Result);
 }
 
+/*
+ * 2D Affine transforms
+ */
+
+static inline affine2d affine2dIdentity(void)
+{
+    affine2d Result;
+    Result.X      = vec2{1.0f, 0.0f};
+    Result.Y      = vec2{0.0f, 1.0f};
+    Result.Offset = vec2{0.0f, 0.0f};
+    
+    return Result;
+}
+
+// NOTE(Sleepster): Translation * Rotation * Scale. An unrotated transform never touches sin or cos.
+static inline affine2d affine2dMakeTRS(vec2 Translation, float Angle, vec2 Scale)
+{
+    affine2d Result;
+    Result.Offset = Translation;
+    if(Angle == 0.0f)
+    {
+        Result.X = vec2{Scale.X, 0.0f};
+        Result.Y = vec2{0.0f, Scale.Y};
+    }
+    else
+    {
+        float SinTheta = SinF(Angle);
+        float CosTheta = CosF(Angle);
+        Result.X = vec2{ CosTheta * Scale.X, SinTheta * Scale.X};
+        Result.Y = vec2{-SinTheta * Scale.Y, CosTheta * Scale.Y};
+    }
+    
+    return Result;
+}
+
+static inline vec2 affine2dTransformVector(affine2d Transform, vec2 Vector)
+{
+    vec2 Result;
+    Result.X = (Transform.X.X * Vector.X) + (Transform.Y.X * Vector.Y);
+    Result.Y = (Transform.X.Y * Vector.X) + (Transform.Y.Y * Vector.Y);
+    
+    return Result;
+}
+
+static inline vec2 affine2dTransformPoint(affine2d Transform, vec2 Point)
+{
+    vec2 Result = affine2dTransformVector(Transform, Point);
+    Result.X += Transform.Offset.X;
+    Result.Y += Transform.Offset.Y;
+    
+    return Result;
+}
+
+// NOTE(Sleepster): Left * Right, so Right is applied first
+static inline affine2d affine2dMultiply(affine2d Left, affine2d Right)
+{
+    affine2d Result;
+    Result.X      = affine2dTransformVector(Left, Right.X);
+    Result.Y      = affine2dTransformVector(Left, Right.Y);
+    Result.Offset = affine2dTransformPoint(Left, Right.Offset);
+    
+    return Result;
+}
+
+static inline float affine2dDeterminant(affine2d Transform)
+{
+    return (Transform.X.X * Transform.Y.Y) - (Transform.Y.X * Transform.X.Y);
+}
+
+static inline affine2d affine2dInverse(affine2d Transform)
+{
+    float InvDeterminant = 1.0f / affine2dDeterminant(Transform);
+    
+    affine2d Result;
+    Result.X      = vec2{ Transform.Y.Y * InvDeterminant, -Transform.X.Y * InvDeterminant};
+    Result.Y      = vec2{-Transform.Y.X * InvDeterminant,  Transform.X.X * InvDeterminant};
+    
+    vec2 Offset   = affine2dTransformVector(Result, Transform.Offset);
+    Result.Offset = vec2{-Offset.X, -Offset.Y};
+    
+    return Result;
+}
+
+// NOTE(Sleepster): Drops Z and the projective row, only valid for matrices that are already affine in XY
+static inline affine2d affine2dFromMat4(mat4 Matrix)
+{
+    affine2d Result;
+    Result.X      = Matrix.Columns[0].XY;
+    Result.Y      = Matrix.Columns[1].XY;
+    Result.Offset = Matrix.Columns[3].XY;
+    
+    return Result;
+}
+
 /*
  * Common graphics transformations
  */